@@ -0,0 +1,110 @@
+// constmat.hpp
+#pragma once
+
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+#include "mir.hpp"
+
+// Materialization of integer constants. Instruction selection loads every
+// constant operand with its own 'li'; before allocation the copies of each
+// value in a block are merged into one virtual register, which the allocator
+// rematerializes rather than spills. After allocation every 'li' is
+// expanded into the shortest real instruction sequence.
+class ConstantMaterializer {
+public:
+    void RunPreRA(MachineProgram &program);
+    void RunPostRA(MachineProgram &program);
+
+    // Shortest sequence that loads value into reg
+    static std::vector<MachineInstr> Materialize(const MachineOperand &reg, int value);
+
+    void Dump() const;
+
+private:
+    void shareConstants(MachineFunction &func);
+
+    int shared = 0;   // 'li' instructions removed by sharing
+    int expanded = 0; // 'li' instructions that needed lui
+};
+
+// Implementations of ConstantMaterializer methods
+
+std::vector<MachineInstr> ConstantMaterializer::Materialize(const MachineOperand &reg, int value) {
+    // addi takes a signed 12-bit immediate, so the upper 20 bits are
+    // rounded to compensate for a negative low part. On RV32 this reaches
+    // every value in at most two instructions; a shift never does better.
+    int lo = (int)((unsigned)value << 20) >> 20;
+    unsigned hi = ((unsigned)value - (unsigned)lo) >> 12;
+    if (hi == 0) {
+        return {MachineInstr("li", {reg, MachineOperand::Imm(lo)})};
+    }
+
+    std::vector<MachineInstr> seq;
+    seq.push_back(MachineInstr("lui", {reg, MachineOperand::Imm(hi)}));
+    if (lo != 0) {
+        seq.push_back(MachineInstr("addi", {reg, reg, MachineOperand::Imm(lo)}));
+    }
+    return seq;
+}
+
+void ConstantMaterializer::RunPreRA(MachineProgram &program) {
+    for (auto &func : program.functions) {
+        shareConstants(*func);
+    }
+}
+
+void ConstantMaterializer::shareConstants(MachineFunction &func) {
+    // Within a block the first 'li' of each value becomes its only
+    // definition, which dominates every later use in the block. Blocks
+    // keep their own copies, so no definition has to move.
+    for (auto &block : func.blocks) {
+        std::unordered_map<int, MachineOperand> constants; // Value -> shared register
+        std::unordered_map<int, MachineOperand> replaced;  // Virtual register -> shared one
+        std::vector<MachineInstr> instrs;
+        for (auto &instr : block->instrs) {
+            if (instr.opcode == "li" && instr.operands[0].kind == MachineOperand::Kind::VirtReg) {
+                auto it = constants.find(instr.operands[1].imm);
+                if (it != constants.end()) {
+                    replaced[instr.operands[0].vreg] = it->second;
+                    shared++;
+                    continue;
+                }
+                constants[instr.operands[1].imm] = instr.operands[0];
+            }
+            for (size_t i = instr.NumDefs(); i < instr.operands.size(); i++) {
+                auto &op = instr.operands[i];
+                if (op.kind == MachineOperand::Kind::VirtReg && replaced.count(op.vreg)) {
+                    op = replaced[op.vreg];
+                }
+            }
+            instrs.push_back(std::move(instr));
+        }
+        block->instrs = std::move(instrs);
+    }
+}
+
+void ConstantMaterializer::RunPostRA(MachineProgram &program) {
+    for (auto &func : program.functions) {
+        for (auto &block : func->blocks) {
+            std::vector<MachineInstr> instrs;
+            for (auto &instr : block->instrs) {
+                if (instr.opcode != "li") {
+                    instrs.push_back(std::move(instr));
+                    continue;
+                }
+                auto seq = Materialize(instr.operands[0], instr.operands[1].imm);
+                if (seq.front().opcode == "lui") {
+                    expanded++;
+                }
+                instrs.insert(instrs.end(), seq.begin(), seq.end());
+            }
+            block->instrs = std::move(instrs);
+        }
+    }
+}
+
+void ConstantMaterializer::Dump() const {
+    std::cout << "ConstMat: " << shared << " shared, "
+              << expanded << " expanded to lui" << std::endl;
+}
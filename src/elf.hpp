@@ -0,0 +1,238 @@
+// elf.hpp
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "mir.hpp"
+#include "encoder.hpp"
+
+// Writes a machine program as an ELF32 relocatable object for RV32IM,
+// the file the assembler would make from MachineProgram::ToString. The
+// object holds .text, empty .data and .bss, a symbol table with every
+// function as a global symbol and, when needed, .rela.text.
+class ObjectWriter {
+public:
+    // Returns the contents of the object file
+    std::string Write(const MachineProgram &program);
+
+private:
+    struct Symbol {
+        std::string name;
+        uint32_t value = 0;
+        uint8_t info = 0; // Binding << 4 | type
+        uint16_t section = 0;
+    };
+
+    void encodeFunction(const MachineFunction &func);
+    uint32_t symbolIndex(const std::string &name);
+
+    static void put8(std::string &out, uint8_t value) { out += (char)value; }
+    static void put16(std::string &out, uint16_t value);
+    static void put32(std::string &out, uint32_t value);
+    static uint32_t addString(std::string &table, const std::string &str);
+
+    std::string text;
+    std::vector<Relocation> relocs;
+    std::vector<Symbol> locals;  // Section symbols and block labels
+    std::vector<Symbol> globals; // Functions, then undefined symbols
+};
+
+// ELF constants used by ObjectWriter
+enum : uint32_t {
+    ET_REL = 1,
+    EM_RISCV = 243,
+    SHT_PROGBITS = 1,
+    SHT_SYMTAB = 2,
+    SHT_STRTAB = 3,
+    SHT_RELA = 4,
+    SHT_NOBITS = 8,
+    SHF_WRITE = 0x1,
+    SHF_ALLOC = 0x2,
+    SHF_EXECINSTR = 0x4,
+    SHF_INFO_LINK = 0x40,
+    STB_LOCAL = 0,
+    STB_GLOBAL = 1,
+    STT_NOTYPE = 0,
+    STT_SECTION = 3,
+};
+
+// Section header indices; .rela.text is only present with relocations
+enum : uint16_t { TEXT_SECTION = 1, DATA_SECTION = 2, BSS_SECTION = 3 };
+
+// Implementations of ObjectWriter methods
+
+void ObjectWriter::put16(std::string &out, uint16_t value) {
+    put8(out, value & 0xff);
+    put8(out, value >> 8);
+}
+
+void ObjectWriter::put32(std::string &out, uint32_t value) {
+    put16(out, value & 0xffff);
+    put16(out, value >> 16);
+}
+
+uint32_t ObjectWriter::addString(std::string &table, const std::string &str) {
+    uint32_t offset = table.size();
+    table += str;
+    table += '\0';
+    return offset;
+}
+
+void ObjectWriter::encodeFunction(const MachineFunction &func) {
+    // Expand pseudo-instructions first, so that every label's offset is
+    // known before any branch to it is encoded
+    std::vector<std::vector<MachineInstr>> blocks;
+    std::unordered_map<std::string, uint32_t> labels;
+    uint32_t pc = text.size();
+    globals.push_back({func.name, pc, STB_GLOBAL << 4 | STT_NOTYPE, TEXT_SECTION});
+    for (size_t b = 0; b < func.blocks.size(); b++) {
+        const auto &block = func.blocks[b];
+        if (b > 0) {
+            labels[block->label] = pc;
+            locals.push_back({block->label, pc, STB_LOCAL << 4 | STT_NOTYPE, TEXT_SECTION});
+        }
+        blocks.emplace_back();
+        for (const auto &instr : block->instrs) {
+            for (auto &base : InstructionEncoder::Expand(instr)) {
+                blocks.back().push_back(std::move(base));
+                pc += 4;
+            }
+        }
+    }
+
+    for (const auto &block : blocks) {
+        for (const auto &instr : block) {
+            put32(text, InstructionEncoder::Encode(instr, text.size(), labels, relocs));
+        }
+    }
+}
+
+uint32_t ObjectWriter::symbolIndex(const std::string &name) {
+    // Globals follow the null symbol and the locals in the symbol table
+    for (size_t i = 0; i < globals.size(); i++) {
+        if (globals[i].name == name) {
+            return 1 + locals.size() + i;
+        }
+    }
+    globals.push_back({name, 0, STB_GLOBAL << 4 | STT_NOTYPE, 0});
+    return locals.size() + globals.size();
+}
+
+std::string ObjectWriter::Write(const MachineProgram &program) {
+    text.clear();
+    relocs.clear();
+    locals.clear();
+    globals.clear();
+    for (uint16_t section : {TEXT_SECTION, DATA_SECTION, BSS_SECTION}) {
+        locals.push_back({"", 0, STB_LOCAL << 4 | STT_SECTION, section});
+    }
+    for (const auto &func : program.functions) {
+        encodeFunction(*func);
+    }
+
+    // Relocations may name symbols no function defines; those become
+    // undefined globals
+    std::string rela;
+    for (const auto &reloc : relocs) {
+        uint32_t sym = reloc.symbol.empty() ? 0 : symbolIndex(reloc.symbol);
+        put32(rela, reloc.offset);
+        put32(rela, sym << 8 | reloc.type);
+        put32(rela, reloc.addend);
+    }
+
+    std::string strtab(1, '\0');
+    std::string symtab(16, '\0');
+    std::vector<Symbol> symbols = locals;
+    symbols.insert(symbols.end(), globals.begin(), globals.end());
+    for (const auto &sym : symbols) {
+        put32(symtab, sym.name.empty() ? 0 : addString(strtab, sym.name));
+        put32(symtab, sym.value);
+        put32(symtab, 0);
+        put8(symtab, sym.info);
+        put8(symtab, 0);
+        put16(symtab, sym.section);
+    }
+
+    struct Section {
+        std::string name;
+        uint32_t type, flags;
+        const std::string *data;
+        uint32_t size, link, info, align, entsize;
+    };
+    const std::string empty;
+    std::vector<Section> sections = {
+        {".text", SHT_PROGBITS, SHF_ALLOC | SHF_EXECINSTR, &text, (uint32_t)text.size(), 0, 0, 4, 0},
+        {".data", SHT_PROGBITS, SHF_WRITE | SHF_ALLOC, &empty, 0, 0, 0, 1, 0},
+        {".bss", SHT_NOBITS, SHF_WRITE | SHF_ALLOC, &empty, 0, 0, 0, 1, 0},
+    };
+    uint32_t symtab_index = sections.size() + (rela.empty() ? 1 : 2);
+    if (!rela.empty()) {
+        sections.push_back({".rela.text", SHT_RELA, SHF_INFO_LINK, &rela, (uint32_t)rela.size(),
+                            symtab_index, TEXT_SECTION, 4, 12});
+    }
+    sections.push_back({".symtab", SHT_SYMTAB, 0, &symtab, (uint32_t)symtab.size(),
+                        symtab_index + 1, 1 + (uint32_t)locals.size(), 4, 16});
+    sections.push_back({".strtab", SHT_STRTAB, 0, &strtab, (uint32_t)strtab.size(), 0, 0, 1, 0});
+    std::string shstrtab(1, '\0');
+    sections.push_back({".shstrtab", SHT_STRTAB, 0, &shstrtab, 0, 0, 0, 1, 0});
+    std::vector<uint32_t> names;
+    for (const auto &section : sections) {
+        names.push_back(addString(shstrtab, section.name));
+    }
+    sections.back().size = shstrtab.size();
+
+    // Section contents follow the 52-byte header, each aligned as it
+    // requires, and the section header table comes last
+    std::string body;
+    std::vector<uint32_t> offsets;
+    for (const auto &section : sections) {
+        while ((52 + body.size()) % section.align != 0) {
+            body += '\0';
+        }
+        offsets.push_back(52 + body.size());
+        if (section.type != SHT_NOBITS) {
+            body += *section.data;
+        }
+    }
+    while ((52 + body.size()) % 4 != 0) {
+        body += '\0';
+    }
+
+    std::string out = "\x7f" "ELF";
+    put8(out, 1); // 32-bit
+    put8(out, 1); // Little endian
+    put8(out, 1); // Current version
+    out.resize(16, '\0');
+    put16(out, ET_REL);
+    put16(out, EM_RISCV);
+    put32(out, 1);                 // Version
+    put32(out, 0);                 // Entry point
+    put32(out, 0);                 // Program header offset
+    put32(out, 52 + body.size());  // Section header offset
+    put32(out, 0);                 // Flags: soft-float ABI, no RVC
+    put16(out, 52);                // Header size
+    put16(out, 0);                 // Program header entry size
+    put16(out, 0);                 // Program header count
+    put16(out, 40);                // Section header entry size
+    put16(out, sections.size() + 1);
+    put16(out, sections.size());   // Index of .shstrtab
+    out += body;
+
+    out.append(40, '\0');
+    for (size_t i = 0; i < sections.size(); i++) {
+        const auto &section = sections[i];
+        put32(out, names[i]);
+        put32(out, section.type);
+        put32(out, section.flags);
+        put32(out, 0);
+        put32(out, offsets[i]);
+        put32(out, section.size);
+        put32(out, section.link);
+        put32(out, section.info);
+        put32(out, section.align);
+        put32(out, section.entsize);
+    }
+    return out;
+}
@@ -0,0 +1,234 @@
+// encoder.hpp
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "mir.hpp"
+#include "constmat.hpp"
+
+// RISC-V relocation types used by the object writer
+enum RelocationType : uint32_t {
+    R_RISCV_BRANCH = 16,
+    R_RISCV_JAL = 17,
+    R_RISCV_CALL_PLT = 19,
+};
+
+// Reference from an encoded instruction to a symbol the encoder cannot
+// resolve on its own. Branches within a function are resolved directly,
+// so no R_RISCV_RELAX is ever emitted: the linker must not shrink code
+// underneath them, as with the assembler's -mno-relax.
+struct Relocation {
+    uint32_t offset; // Of the instruction, from the start of .text
+    std::string symbol;
+    uint32_t type;
+    int32_t addend = 0;
+};
+
+// Instruction format, opcode and function fields of a base instruction.
+// For immediate shifts funct7 is the upper part of the immediate.
+struct Encoding {
+    char format; // R, I, L (load), S, B, U or J
+    uint32_t opcode;
+    uint32_t funct3;
+    uint32_t funct7;
+};
+
+static const std::unordered_map<std::string, Encoding> rv32im_encodings = {
+    {"add", {'R', 0x33, 0, 0x00}},   {"sub", {'R', 0x33, 0, 0x20}},
+    {"sll", {'R', 0x33, 1, 0x00}},   {"slt", {'R', 0x33, 2, 0x00}},
+    {"sltu", {'R', 0x33, 3, 0x00}},  {"xor", {'R', 0x33, 4, 0x00}},
+    {"srl", {'R', 0x33, 5, 0x00}},   {"sra", {'R', 0x33, 5, 0x20}},
+    {"or", {'R', 0x33, 6, 0x00}},    {"and", {'R', 0x33, 7, 0x00}},
+    {"mul", {'R', 0x33, 0, 0x01}},   {"mulh", {'R', 0x33, 1, 0x01}},
+    {"mulhsu", {'R', 0x33, 2, 0x01}}, {"mulhu", {'R', 0x33, 3, 0x01}},
+    {"div", {'R', 0x33, 4, 0x01}},   {"divu", {'R', 0x33, 5, 0x01}},
+    {"rem", {'R', 0x33, 6, 0x01}},   {"remu", {'R', 0x33, 7, 0x01}},
+    {"addi", {'I', 0x13, 0, 0x00}},  {"slti", {'I', 0x13, 2, 0x00}},
+    {"sltiu", {'I', 0x13, 3, 0x00}}, {"xori", {'I', 0x13, 4, 0x00}},
+    {"ori", {'I', 0x13, 6, 0x00}},   {"andi", {'I', 0x13, 7, 0x00}},
+    {"slli", {'I', 0x13, 1, 0x00}},  {"srli", {'I', 0x13, 5, 0x00}},
+    {"srai", {'I', 0x13, 5, 0x20}},  {"jalr", {'I', 0x67, 0, 0x00}},
+    {"lw", {'L', 0x03, 2, 0x00}},    {"sw", {'S', 0x23, 2, 0x00}},
+    {"beq", {'B', 0x63, 0, 0x00}},   {"bne", {'B', 0x63, 1, 0x00}},
+    {"blt", {'B', 0x63, 4, 0x00}},   {"bge", {'B', 0x63, 5, 0x00}},
+    {"bltu", {'B', 0x63, 6, 0x00}},  {"bgeu", {'B', 0x63, 7, 0x00}},
+    {"lui", {'U', 0x37, 0, 0x00}},   {"auipc", {'U', 0x17, 0, 0x00}},
+    {"jal", {'J', 0x6f, 0, 0x00}},
+};
+
+// Encodes machine instructions, after register allocation, into RV32IM
+// machine code
+class InstructionEncoder {
+public:
+    // Rewrites an assembler pseudo-instruction into the base instructions
+    // the assembler would produce; base instructions are returned as is
+    static std::vector<MachineInstr> Expand(const MachineInstr &instr);
+
+    // Encodes a base instruction at offset pc of .text. Labels of the
+    // current function are resolved through labels; any other symbol is
+    // left to a relocation appended to relocs.
+    static uint32_t Encode(const MachineInstr &instr, uint32_t pc,
+                           const std::unordered_map<std::string, uint32_t> &labels,
+                           std::vector<Relocation> &relocs);
+
+    static uint32_t RegisterNumber(const MachineOperand &reg);
+
+private:
+    // Returns value, after checking that it is in range for instr
+    static int32_t checkImm(const MachineInstr &instr, int64_t value, bool in_range);
+};
+
+// Implementations of InstructionEncoder methods
+
+std::vector<MachineInstr> InstructionEncoder::Expand(const MachineInstr &instr) {
+    const auto &ops = instr.operands;
+    auto x0 = MachineOperand::PReg("x0");
+    auto ra = MachineOperand::PReg("ra");
+    const std::string &opc = instr.opcode;
+
+    if (opc == "li") {
+        std::vector<MachineInstr> seq;
+        for (auto &part : ConstantMaterializer::Materialize(ops[0], ops[1].imm)) {
+            if (part.opcode == "li") {
+                part = MachineInstr("addi", {ops[0], x0, part.operands[1]});
+            }
+            seq.push_back(part);
+        }
+        return seq;
+    }
+    if (opc == "mv") {
+        return {MachineInstr("addi", {ops[0], ops[1], MachineOperand::Imm(0)})};
+    }
+    if (opc == "seqz") {
+        return {MachineInstr("sltiu", {ops[0], ops[1], MachineOperand::Imm(1)})};
+    }
+    if (opc == "snez") {
+        return {MachineInstr("sltu", {ops[0], x0, ops[1]})};
+    }
+    if (opc == "neg") {
+        return {MachineInstr("sub", {ops[0], x0, ops[1]})};
+    }
+    if (opc == "not") {
+        return {MachineInstr("xori", {ops[0], ops[1], MachineOperand::Imm(-1)})};
+    }
+    if (opc == "nop") {
+        return {MachineInstr("addi", {x0, x0, MachineOperand::Imm(0)})};
+    }
+    if (opc == "ret") {
+        return {MachineInstr("jalr", {x0, ra, MachineOperand::Imm(0)})};
+    }
+    if (opc == "j") {
+        return {MachineInstr("jal", {x0, ops[0]})};
+    }
+    if (opc == "beqz" || opc == "bnez") {
+        return {MachineInstr(opc == "beqz" ? "beq" : "bne", {ops[0], x0, ops[1]})};
+    }
+    if (opc == "call") {
+        // auipc/jalr pair, patched by the linker through R_RISCV_CALL_PLT
+        return {MachineInstr("auipc", {ra, ops[0]}),
+                MachineInstr("jalr", {ra, ra, MachineOperand::Imm(0)})};
+    }
+    return {instr};
+}
+
+uint32_t InstructionEncoder::RegisterNumber(const MachineOperand &reg) {
+    static const std::unordered_map<std::string, uint32_t> numbers = {
+        {"zero", 0}, {"x0", 0}, {"ra", 1}, {"sp", 2}, {"gp", 3}, {"tp", 4},
+        {"t0", 5}, {"t1", 6}, {"t2", 7}, {"s0", 8}, {"fp", 8}, {"s1", 9},
+        {"a0", 10}, {"a1", 11}, {"a2", 12}, {"a3", 13}, {"a4", 14}, {"a5", 15},
+        {"a6", 16}, {"a7", 17}, {"s2", 18}, {"s3", 19}, {"s4", 20}, {"s5", 21},
+        {"s6", 22}, {"s7", 23}, {"s8", 24}, {"s9", 25}, {"s10", 26}, {"s11", 27},
+        {"t3", 28}, {"t4", 29}, {"t5", 30}, {"t6", 31},
+    };
+    auto it = numbers.find(reg.reg);
+    if (reg.kind != MachineOperand::Kind::PhysReg || it == numbers.end()) {
+        std::cerr << "Error: Cannot encode register " << reg.ToString() << std::endl;
+        exit(1);
+    }
+    return it->second;
+}
+
+int32_t InstructionEncoder::checkImm(const MachineInstr &instr, int64_t value, bool in_range) {
+    if (!in_range) {
+        std::cerr << "Error: Immediate out of range in" << instr.ToString();
+        exit(1);
+    }
+    return (int32_t)value;
+}
+
+uint32_t InstructionEncoder::Encode(const MachineInstr &instr, uint32_t pc,
+                                    const std::unordered_map<std::string, uint32_t> &labels,
+                                    std::vector<Relocation> &relocs) {
+    auto it = rv32im_encodings.find(instr.opcode);
+    if (it == rv32im_encodings.end()) {
+        std::cerr << "Error: Cannot encode instruction" << instr.ToString();
+        exit(1);
+    }
+    const Encoding &enc = it->second;
+    const auto &ops = instr.operands;
+
+    // Distance to a label of this function, or 0 plus a relocation
+    auto target = [&](const MachineOperand &label, uint32_t type) -> int64_t {
+        auto found = labels.find(label.label);
+        if (found != labels.end()) {
+            return (int64_t)found->second - pc;
+        }
+        relocs.push_back({pc, label.label, type});
+        return 0;
+    };
+
+    switch (enc.format) {
+    case 'R':
+        return enc.funct7 << 25 | RegisterNumber(ops[2]) << 20 | RegisterNumber(ops[1]) << 15 |
+               enc.funct3 << 12 | RegisterNumber(ops[0]) << 7 | enc.opcode;
+    case 'I': {
+        uint32_t imm;
+        if (instr.opcode == "slli" || instr.opcode == "srli" || instr.opcode == "srai") {
+            imm = enc.funct7 << 5 | checkImm(instr, ops[2].imm, ops[2].imm >= 0 && ops[2].imm <= 31);
+        }
+        else {
+            imm = checkImm(instr, ops[2].imm, FitsImm12(ops[2].imm)) & 0xfff;
+        }
+        return imm << 20 | RegisterNumber(ops[1]) << 15 | enc.funct3 << 12 |
+               RegisterNumber(ops[0]) << 7 | enc.opcode;
+    }
+    case 'L': {
+        uint32_t imm = checkImm(instr, ops[1].imm, FitsImm12(ops[1].imm)) & 0xfff;
+        return imm << 20 | RegisterNumber(MachineOperand::PReg(ops[1].reg)) << 15 | enc.funct3 << 12 |
+               RegisterNumber(ops[0]) << 7 | enc.opcode;
+    }
+    case 'S': {
+        uint32_t imm = checkImm(instr, ops[1].imm, FitsImm12(ops[1].imm)) & 0xfff;
+        return (imm >> 5) << 25 | RegisterNumber(ops[0]) << 20 |
+               RegisterNumber(MachineOperand::PReg(ops[1].reg)) << 15 | enc.funct3 << 12 |
+               (imm & 0x1f) << 7 | enc.opcode;
+    }
+    case 'B': {
+        int64_t offset = target(ops[2], R_RISCV_BRANCH);
+        uint32_t imm = checkImm(instr, offset, offset >= -4096 && offset <= 4094);
+        return (imm >> 12 & 1) << 31 | (imm >> 5 & 0x3f) << 25 | RegisterNumber(ops[1]) << 20 |
+               RegisterNumber(ops[0]) << 15 | enc.funct3 << 12 | (imm >> 1 & 0xf) << 8 |
+               (imm >> 11 & 1) << 7 | enc.opcode;
+    }
+    case 'U': {
+        uint32_t imm = 0;
+        if (ops[1].kind == MachineOperand::Kind::Label) {
+            target(ops[1], R_RISCV_CALL_PLT);
+        }
+        else {
+            imm = checkImm(instr, ops[1].imm, ops[1].imm >= 0 && ops[1].imm <= 0xfffff);
+        }
+        return imm << 12 | RegisterNumber(ops[0]) << 7 | enc.opcode;
+    }
+    case 'J': {
+        int64_t offset = target(ops[1], R_RISCV_JAL);
+        uint32_t imm = checkImm(instr, offset, offset >= -(1 << 20) && offset <= (1 << 20) - 2);
+        return (imm >> 20 & 1) << 31 | (imm >> 1 & 0x3ff) << 21 | (imm >> 11 & 1) << 20 |
+               (imm >> 12 & 0xff) << 12 | RegisterNumber(ops[0]) << 7 | enc.opcode;
+    }
+    }
+    return 0;
+}
@@ -0,0 +1,161 @@
+// frame.hpp
+#pragma once
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+#include "mir.hpp"
+
+// Registers a function must preserve for its caller. s0 is left out since
+// it doubles as the frame pointer.
+static const std::vector<std::string> callee_saved_regs = {
+    "s1", "s2", "s3", "s4", "s5", "s6", "s7", "s8", "s9", "s10", "s11",
+};
+
+// Lays out the stack frame of a function once register allocation is done.
+// From sp upwards the frame holds the spill slots, the callee-saved
+// registers the function uses, and ra when the function makes calls.
+// Frames of any size are supported: offsets beyond the 12-bit immediate
+// go through the scratch registers t5 and t6.
+class FrameLowering {
+public:
+    // Takes the live range [start, end] of every spilled value and returns
+    // the sp offset of each, in the order given
+    std::vector<int> AssignSpillSlots(const std::vector<std::pair<int, int>> &spill_ranges);
+
+    // Fills in func.frame and inserts the prologue and epilogues
+    void Run(MachineFunction &func, const std::vector<std::string> &used_regs);
+
+    int spill_slots = 0; // Slots used, after sharing
+    int saved_regs = 0;  // Registers saved by the last Run, including ra
+
+private:
+    static bool isLeaf(const MachineFunction &func);
+
+    // Rewrites sp adjustments and sp-relative accesses whose offset does
+    // not fit an immediate
+    static void legalizeOffsets(MachineFunction &func);
+};
+
+// Implementations of FrameLowering methods
+
+bool FrameLowering::isLeaf(const MachineFunction &func) {
+    for (const auto &block : func.blocks) {
+        for (const auto &instr : block->instrs) {
+            if (instr.opcode == "call") {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+std::vector<int> FrameLowering::AssignSpillSlots(const std::vector<std::pair<int, int>> &spill_ranges) {
+    // Ranges are visited by start and a slot is reused once the range
+    // occupying it has ended
+    std::vector<size_t> order(spill_ranges.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return spill_ranges[a].first < spill_ranges[b].first;
+    });
+
+    std::vector<int> offsets(spill_ranges.size());
+    std::vector<int> slot_end; // Last position occupied, per slot
+    for (size_t i : order) {
+        size_t slot = 0;
+        while (slot < slot_end.size() && slot_end[slot] >= spill_ranges[i].first) {
+            slot++;
+        }
+        if (slot == slot_end.size()) {
+            slot_end.push_back(0);
+        }
+        slot_end[slot] = spill_ranges[i].second;
+        offsets[i] = slot * 4;
+    }
+    spill_slots = slot_end.size();
+    return offsets;
+}
+
+void FrameLowering::Run(MachineFunction &func, const std::vector<std::string> &used_regs) {
+    // Save area: only the callee-saved registers actually allocated
+    StackFrame frame;
+    int offset = spill_slots * 4;
+    for (const auto &reg : callee_saved_regs) {
+        if (std::find(used_regs.begin(), used_regs.end(), reg) != used_regs.end()) {
+            frame.saved_regs.push_back({reg, offset});
+            offset += 4;
+        }
+    }
+
+    bool leaf = isLeaf(func);
+    frame.size = offset + (leaf ? 0 : 4);
+    frame.size = (frame.size + 15) / 16 * 16;
+    if (!leaf) {
+        frame.saved_regs.push_back({"ra", frame.size - 4});
+    }
+    saved_regs = frame.saved_regs.size();
+
+    func.frame = frame;
+    if (frame.size == 0) {
+        return;
+    }
+
+    auto sp = MachineOperand::PReg("sp");
+    std::vector<MachineInstr> prologue;
+    prologue.push_back(MachineInstr("addi", {sp, sp, MachineOperand::Imm(-frame.size)}));
+    for (const auto &saved : frame.saved_regs) {
+        prologue.push_back(MachineInstr("sw", {MachineOperand::PReg(saved.first),
+                                               MachineOperand::Mem("sp", saved.second)}));
+    }
+    auto &entry = func.blocks.front()->instrs;
+    entry.insert(entry.begin(), prologue.begin(), prologue.end());
+
+    for (auto &block : func.blocks) {
+        std::vector<MachineInstr> instrs;
+        for (auto &instr : block->instrs) {
+            if (instr.opcode == "ret") {
+                for (const auto &saved : frame.saved_regs) {
+                    instrs.push_back(MachineInstr("lw", {MachineOperand::PReg(saved.first),
+                                                         MachineOperand::Mem("sp", saved.second)}));
+                }
+                instrs.push_back(MachineInstr("addi", {sp, sp, MachineOperand::Imm(frame.size)}));
+            }
+            instrs.push_back(std::move(instr));
+        }
+        block->instrs = std::move(instrs);
+    }
+    legalizeOffsets(func);
+}
+
+void FrameLowering::legalizeOffsets(MachineFunction &func) {
+    auto sp = MachineOperand::PReg("sp");
+    auto t5 = MachineOperand::PReg("t5");
+    auto t6 = MachineOperand::PReg("t6");
+    for (auto &block : func.blocks) {
+        std::vector<MachineInstr> instrs;
+        for (auto &instr : block->instrs) {
+            auto &ops = instr.operands;
+            if (instr.opcode == "addi" && ops[0] == sp && !FitsImm12(ops[2].imm)) {
+                // t5 is free around the prologue and epilogues
+                instrs.push_back(MachineInstr("li", {t5, ops[2]}));
+                instrs.push_back(MachineInstr("add", {sp, sp, t5}));
+                continue;
+            }
+            bool is_load = instr.opcode == "lw";
+            if ((is_load || instr.opcode == "sw") && ops[1].reg == "sp" && !FitsImm12(ops[1].imm)) {
+                // A load forms the address in its own destination. Stores
+                // come from t5 or a saved register in the prologue, and t6
+                // is free at both.
+                auto addr = is_load ? ops[0] : (ops[0] == t6 ? t5 : t6);
+                instrs.push_back(MachineInstr("li", {addr, MachineOperand::Imm(ops[1].imm)}));
+                instrs.push_back(MachineInstr("add", {addr, addr, sp}));
+                ops[1] = MachineOperand::Mem(addr.reg, 0);
+            }
+            instrs.push_back(std::move(instr));
+        }
+        block->instrs = std::move(instrs);
+    }
+}
@@ -11,7 +11,6 @@ class IRNode {
 public:
     virtual ~IRNode() = default;
     virtual std::string ToString() const = 0;
-    virtual std::string GenerateAssembly(std::function<std::string(const std::string&)> getRegisterFunc) const = 0;
 };
 
 // Instruction IR
@@ -38,18 +37,6 @@ public:
             return "    ret " + str_value + "\n";
         }
     }
-
-    std::string GenerateAssembly(std::function<std::string(const std::string&)> getRegisterFunc) const override {
-        std::string asm_code;
-        if (is_constant) {
-            asm_code += "    li a0, " + std::to_string(int_value) + "\n";
-        } else {
-            std::string reg = getRegisterFunc(str_value);
-            asm_code += "    mv a0, " + reg + "\n";
-        }
-        asm_code += "    ret\n";
-        return asm_code;
-    }
 };
 
 // Load immediate instruction
@@ -64,13 +51,6 @@ public:
     std::string ToString() const override {
         return "    " + dest + " = " + std::to_string(value) + "\n";
     }
-
-    std::string GenerateAssembly(std::function<std::string(const std::string&)> getRegisterFunc) const override {
-        std::string asm_code;
-        std::string reg = getRegisterFunc(dest);
-        asm_code += "    li " + reg + ", " + std::to_string(value) + "\n";
-        return asm_code;
-    }
 };
 
 // Binary operation instruction
@@ -87,112 +67,6 @@ public:
     std::string ToString() const override {
         return "    " + dest + " = " + op + " " + lhs + ", " + rhs + "\n";
     }
-
-    std::string GenerateAssembly(std::function<std::string(const std::string&)> getRegisterFunc) const override {
-        std::string asm_code;
-        std::string rd = getRegisterFunc(dest);
-
-        bool lhs_const = (std::isdigit(lhs[0]) && lhs != "0") || (lhs[0] == '-' && lhs.size() > 1);
-        bool rhs_const = (std::isdigit(rhs[0]) && rhs != "0") || (rhs[0] == '-' && rhs.size() > 1);
-
-        std::string rs1, rs2;
-
-        if (lhs_const && rhs_const) {
-            // Both operands are constants
-            rs1 = rd;
-            asm_code += "    li " + rs1 + ", " + lhs + "\n";
-
-            std::string temp_reg = getRegisterFunc(rhs);
-            rs2 = temp_reg;
-            asm_code += "    li " + rs2 + ", " + rhs + "\n";
-        }
-        else {
-            // Handle single constant operand
-            if (lhs_const) {
-                rs1 = rd;
-                asm_code += "    li " + rs1 + ", " + lhs + "\n";
-            }
-            else {
-                rs1 = getRegisterFunc(lhs);
-            }
-
-            if (rhs_const) {
-                rs2 = rd;
-                asm_code += "    li " + rs2 + ", " + rhs + "\n";
-            }
-            else {
-                rs2 = getRegisterFunc(rhs);
-            }
-        }
-
-        // Generate corresponding operation instruction
-        if (op == "add") {
-            asm_code += "    add " + rd + ", " + rs1 + ", " + rs2 + "\n";
-        }
-        else if (op == "sub") {
-            asm_code += "    sub " + rd + ", " + rs1 + ", " + rs2 + "\n";
-        }
-        else if (op == "mul") {
-            asm_code += "    mul " + rd + ", " + rs1 + ", " + rs2 + "\n";
-        }
-        else if (op == "div") {
-            asm_code += "    div " + rd + ", " + rs1 + ", " + rs2 + "\n";
-        }
-        else if (op == "mod") {
-            asm_code += "    rem " + rd + ", " + rs1 + ", " + rs2 + "\n";
-        }
-        else if (op == "eq") {
-            asm_code += "    xor " + rd + ", " + rs1 + ", " + rs2 + "\n";
-            asm_code += "    seqz " + rd + ", " + rd + "\n";
-        }
-        else if (op == "ne") {
-            asm_code += "    xor " + rd + ", " + rs1 + ", " + rs2 + "\n";
-            asm_code += "    snez " + rd + ", " + rd + "\n";
-        }
-        else if (op == "lt") {
-            asm_code += "    sub " + rd + ", " + rs1 + ", " + rs2 + "\n";
-            asm_code += "    sltz " + rd + ", " + rd + "\n";
-        }
-        else if (op == "gt") {
-            asm_code += "    slt " + rd + ", " + rs2 + ", " + rs1 + "\n";
-        }
-        else if (op == "le") {
-            // Implement 'le' as !(lhs > rhs)
-            std::string temp = getRegisterFunc(dest + "_temp");
-            asm_code += "    sub " + temp + ", " + rs2 + ", " + rs1 + "\n";
-            asm_code += "    srai " + temp + ", " + temp + ", 31\n";
-            asm_code += "    snez " + temp + ", " + temp + "\n";
-            asm_code += "    seqz " + rd + ", " + temp + "\n";
-        }
-        else if (op == "ge") {
-            // Implement 'ge' as !(lhs < rhs)
-            std::string temp = getRegisterFunc(dest + "_temp");
-            asm_code += "    sub " + temp + ", " + rs1 + ", " + rs2 + "\n";
-            asm_code += "    srai " + temp + ", " + temp + ", 31\n";
-            asm_code += "    snez " + temp + ", " + temp + "\n";
-            asm_code += "    seqz " + rd + ", " + temp + "\n"; 
-        }
-        else if (op == "and") {
-            // Implement '&&' as (lhs != 0) && (rhs != 0)
-            asm_code += "    snez " + rd + ", " + rs1 + "\n";
-            std::string temp = getRegisterFunc(dest + "_temp");
-            asm_code += "    snez " + temp + ", " + rs2 + "\n";
-            asm_code += "    and " + rd + ", " + rd + ", " + temp + "\n";
-        }
-        else if (op == "or") {
-            // Implement '||' as (lhs != 0) || (rhs != 0)
-            asm_code += "    snez " + rd + ", " + rs1 + "\n";
-            std::string temp = getRegisterFunc(dest + "_temp");
-            asm_code += "    snez " + temp + ", " + rs2 + "\n";
-            asm_code += "    or " + rd + ", " + rd + ", " + temp + "\n";
-        }
-        else {
-            std::cerr << "Unsupported binary operator: " << op << std::endl;
-            exit(1);
-        }
-
-        return asm_code;
-    }
 };
 
 // Basic block IR
@@ -214,14 +88,6 @@ public:
         }
         return ir;
     }
-
-    std::string GenerateAssembly(std::function<std::string(const std::string&)> getRegisterFunc) const override {
-        std::string asm_code;
-        for (const auto &instr : instructions) {
-            asm_code += instr->GenerateAssembly(getRegisterFunc);
-        }
-        return asm_code;
-    }
 };
 
 // Function IR
@@ -244,17 +110,6 @@ public:
         ir += "}\n";
         return ir;
     }
-
-    std::string GenerateAssembly(std::function<std::string(const std::string&)> getRegisterFunc) const override {
-        std::string asm_code;
-        asm_code += "    .text\n";
-        asm_code += "    .globl " + name + "\n";
-        asm_code += name + ":\n";
-        for (const auto &block : blocks) {
-            asm_code += block->GenerateAssembly(getRegisterFunc);
-        }
-        return asm_code;
-    }
 };
 
 // Program IR
@@ -273,12 +128,4 @@ public:
         }
         return ir;
     }
-
-    std::string GenerateAssembly(std::function<std::string(const std::string&)> getRegisterFunc) const override {
-        std::string asm_code;
-        for (const auto &func : functions) {
-            asm_code += func->GenerateAssembly(getRegisterFunc);
-        }
-        return asm_code;
-    }
 };
@@ -0,0 +1,383 @@
+// isel.hpp
+#pragma once
+
+#include <climits>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "ir.hpp"
+#include "mir.hpp"
+#include "patterns.hpp"
+
+// Node of an expression tree built from the IR of one block. A temporary
+// with a single use in the same block becomes a subtree of its user;
+// any other temporary is a leaf holding the register it was selected into.
+struct ExprNode {
+    enum class Kind { Const, Value, Op };
+
+    Kind kind = Kind::Const;
+    int value = 0;          // Const
+    MachineOperand reg;     // Value
+    bool is_bool = false;   // Value
+    std::string op;         // Op
+    std::vector<ExprNode *> kids;
+
+    // Cheapest rule and its cost for each nonterminal, filled in by labeling
+    int cost[2] = {INT_MAX, INT_MAX};
+    int rule[2] = {-1, -1};
+};
+
+// Lowers ProgramIR to machine IR over virtual registers. Expressions are
+// covered by the cheapest tiling of the rules in riscv_patterns, found by
+// bottom-up dynamic programming over each expression tree (BURS style).
+class InstructionSelector {
+public:
+    InstructionSelector();
+
+    std::unique_ptr<MachineProgram> Run(const ProgramIR &program);
+
+    void Dump() const;
+
+private:
+    enum Nonterminal { Reg = 0, Bool = 1 };
+
+    struct Rule {
+        Nonterminal result;
+        PatternTree tree;
+        int cost;
+        std::string code;
+    };
+
+    std::unique_ptr<MachineFunction> selectFunction(const FunctionIR &func);
+    void selectInstruction(const InstructionIR *instr);
+    void selectReturn(const ReturnIR *instr);
+    void selectLoadImm(const LoadImmIR *instr);
+    void selectBinaryOp(const BinaryOpIR *instr);
+
+    ExprNode *buildOperand(const std::string &value);
+    void label(ExprNode *node);
+    bool match(const PatternTree &tree, const ExprNode *node, int &cost) const;
+    MachineOperand reduce(ExprNode *node, Nonterminal nt);
+    void bindLeaves(const PatternTree &tree, ExprNode *node, std::vector<MachineOperand> &leaves);
+    MachineOperand emitCode(const Rule &rule, const std::vector<MachineOperand> &leaves);
+    void emit(const std::string &opcode, std::vector<MachineOperand> operands);
+
+    std::vector<Rule> rules;
+    std::vector<int> rule_hits; // Per rule, times selected
+
+    MachineFunction *current_function = nullptr;
+    MachineBasicBlock *current_block = nullptr;
+    std::unordered_map<std::string, MachineOperand> vreg_map; // IR temp -> virtual register
+    std::unordered_set<int> bool_vregs;                       // Virtual registers holding 0 or 1
+    std::unordered_map<std::string, int> use_count;           // IR temp -> uses in the function
+    std::unordered_map<std::string, ExprNode *> pending;      // Single-use temps not yet selected
+    std::vector<std::unique_ptr<ExprNode>> nodes;             // Owns the trees of the current block
+};
+
+// Implementations of InstructionSelector methods
+
+InstructionSelector::InstructionSelector() {
+    for (const auto &pattern : riscv_patterns) {
+        Nonterminal result = std::string(pattern.result) == "bool" ? Bool : Reg;
+        rules.push_back({result, ParsePatternTree(pattern.tree), pattern.cost, pattern.code});
+    }
+    rule_hits.assign(rules.size(), 0);
+}
+
+std::unique_ptr<MachineProgram> InstructionSelector::Run(const ProgramIR &program) {
+    auto mprogram = std::make_unique<MachineProgram>();
+    for (const auto &func : program.functions) {
+        mprogram->AddFunction(selectFunction(*func));
+    }
+    return mprogram;
+}
+
+std::unique_ptr<MachineFunction> InstructionSelector::selectFunction(const FunctionIR &func) {
+    auto mfunc = std::make_unique<MachineFunction>(func.name);
+    current_function = mfunc.get();
+    vreg_map.clear();
+    bool_vregs.clear();
+
+    use_count.clear();
+    for (const auto &block : func.blocks) {
+        for (const auto &instr : block->instructions) {
+            if (auto binary_op = dynamic_cast<const BinaryOpIR *>(instr.get())) {
+                use_count[binary_op->lhs]++;
+                use_count[binary_op->rhs]++;
+            }
+            else if (auto ret = dynamic_cast<const ReturnIR *>(instr.get())) {
+                if (!ret->is_constant) {
+                    use_count[ret->str_value]++;
+                }
+            }
+        }
+    }
+
+    for (const auto &block : func.blocks) {
+        auto mblock = std::make_unique<MachineBasicBlock>(block->label);
+        current_block = mblock.get();
+        for (const auto &instr : block->instructions) {
+            selectInstruction(instr.get());
+        }
+        // Trees never extend across blocks
+        for (const auto &entry : pending) {
+            vreg_map[entry.first] = reduce(entry.second, Reg);
+        }
+        pending.clear();
+        nodes.clear();
+        mfunc->AddBlock(std::move(mblock));
+    }
+
+    current_function = nullptr;
+    current_block = nullptr;
+    return mfunc;
+}
+
+void InstructionSelector::selectInstruction(const InstructionIR *instr) {
+    if (auto ret = dynamic_cast<const ReturnIR *>(instr)) {
+        selectReturn(ret);
+    }
+    else if (auto load_imm = dynamic_cast<const LoadImmIR *>(instr)) {
+        selectLoadImm(load_imm);
+    }
+    else if (auto binary_op = dynamic_cast<const BinaryOpIR *>(instr)) {
+        selectBinaryOp(binary_op);
+    }
+    else {
+        std::cerr << "Unsupported IR instruction: " << instr->ToString();
+        exit(1);
+    }
+}
+
+void InstructionSelector::selectReturn(const ReturnIR *instr) {
+    auto a0 = MachineOperand::PReg("a0");
+    if (instr->is_constant) {
+        emit("li", {a0, MachineOperand::Imm(instr->int_value)});
+    }
+    else {
+        ExprNode *value = buildOperand(instr->str_value);
+        label(value);
+        emit("mv", {a0, reduce(value, Reg)});
+    }
+
+    MachineInstr ret("ret");
+    ret.implicit_uses.push_back(a0);
+    current_block->AddInstr(std::move(ret));
+}
+
+void InstructionSelector::selectLoadImm(const LoadImmIR *instr) {
+    auto rd = current_function->NewVReg();
+    emit("li", {rd, MachineOperand::Imm(instr->value)});
+    vreg_map[instr->dest] = rd;
+}
+
+void InstructionSelector::selectBinaryOp(const BinaryOpIR *instr) {
+    nodes.push_back(std::make_unique<ExprNode>());
+    ExprNode *node = nodes.back().get();
+    node->kind = ExprNode::Kind::Op;
+    node->op = instr->op;
+    node->kids = {buildOperand(instr->lhs), buildOperand(instr->rhs)};
+    label(node);
+
+    if (node->cost[Reg] == INT_MAX) {
+        std::cerr << "Unsupported binary operator: " << instr->op << std::endl;
+        exit(1);
+    }
+
+    // A value with a single use waits to be covered together with its user
+    if (use_count[instr->dest] == 1) {
+        pending[instr->dest] = node;
+        return;
+    }
+    vreg_map[instr->dest] = reduce(node, Reg);
+}
+
+ExprNode *InstructionSelector::buildOperand(const std::string &value) {
+    auto it = pending.find(value);
+    if (it != pending.end()) {
+        ExprNode *node = it->second;
+        pending.erase(it);
+        return node;
+    }
+
+    nodes.push_back(std::make_unique<ExprNode>());
+    ExprNode *node = nodes.back().get();
+    if (value[0] != '%') {
+        node->kind = ExprNode::Kind::Const;
+        node->value = std::stoi(value);
+        label(node);
+        return node;
+    }
+
+    auto reg = vreg_map.find(value);
+    if (reg == vreg_map.end()) {
+        std::cerr << "Error: " << value << " used before definition\n";
+        exit(1);
+    }
+    node->kind = ExprNode::Kind::Value;
+    node->reg = reg->second;
+    node->is_bool = reg->second.kind == MachineOperand::Kind::VirtReg && bool_vregs.count(reg->second.vreg);
+    node->cost[Reg] = 0;
+    node->cost[Bool] = node->is_bool ? 0 : INT_MAX;
+    return node;
+}
+
+void InstructionSelector::label(ExprNode *node) {
+    // Subtrees are labeled when they are built, so only the rules rooted
+    // at this node remain to be tried
+    if (node->kind == ExprNode::Kind::Value) {
+        return;
+    }
+    for (size_t i = 0; i < rules.size(); i++) {
+        int cost = rules[i].cost;
+        if (!match(rules[i].tree, node, cost)) {
+            continue;
+        }
+        for (int nt = rules[i].result; nt >= Reg; nt--) {
+            if (cost < node->cost[nt]) {
+                node->cost[nt] = cost;
+                node->rule[nt] = i;
+            }
+        }
+    }
+}
+
+bool InstructionSelector::match(const PatternTree &tree, const ExprNode *node, int &cost) const {
+    const std::string &op = tree.op;
+    if (op == "reg" || op == "bool") {
+        int leaf_cost = node->cost[op == "bool" ? Bool : Reg];
+        if (leaf_cost == INT_MAX) {
+            return false;
+        }
+        cost += leaf_cost;
+        return true;
+    }
+
+    if (tree.kids.empty()) {
+        if (node->kind != ExprNode::Kind::Const) {
+            return false;
+        }
+        long long c = node->value;
+        bool pow2 = c > 0 && (c & (c - 1)) == 0;
+        return (op == "zero" && c == 0) || op == "imm" || (op == "bit" && (c == 0 || c == 1)) ||
+               (op == "imm12" && FitsImm12(c)) || (op == "nimm12" && FitsImm12(-c)) ||
+               (op == "imm12p1" && FitsImm12(c + 1)) || (op == "shamt" && pow2) ||
+               (op == "mask" && pow2 && c <= 2048);
+    }
+
+    if (node->kind != ExprNode::Kind::Op || node->op != op) {
+        return false;
+    }
+    for (size_t i = 0; i < tree.kids.size(); i++) {
+        if (!match(tree.kids[i], node->kids[i], cost)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+MachineOperand InstructionSelector::reduce(ExprNode *node, Nonterminal nt) {
+    if (node->kind == ExprNode::Kind::Value) {
+        return node->reg;
+    }
+
+    const Rule &rule = rules[node->rule[nt]];
+    rule_hits[node->rule[nt]]++;
+    std::vector<MachineOperand> leaves;
+    bindLeaves(rule.tree, node, leaves);
+    MachineOperand result = emitCode(rule, leaves);
+    if (rule.result == Bool && result.kind == MachineOperand::Kind::VirtReg) {
+        bool_vregs.insert(result.vreg);
+    }
+    return result;
+}
+
+void InstructionSelector::bindLeaves(const PatternTree &tree, ExprNode *node,
+                                     std::vector<MachineOperand> &leaves) {
+    const std::string &op = tree.op;
+    if (op == "reg" || op == "bool") {
+        leaves.push_back(reduce(node, op == "bool" ? Bool : Reg));
+    }
+    else if (op == "zero") {
+        leaves.push_back(MachineOperand::PReg("x0"));
+    }
+    else if (op == "nimm12") {
+        leaves.push_back(MachineOperand::Imm(-node->value));
+    }
+    else if (op == "imm12p1") {
+        leaves.push_back(MachineOperand::Imm(node->value + 1));
+    }
+    else if (op == "shamt") {
+        int shift = 0;
+        while ((1 << shift) != node->value) {
+            shift++;
+        }
+        leaves.push_back(MachineOperand::Imm(shift));
+    }
+    else if (op == "mask") {
+        leaves.push_back(MachineOperand::Imm(node->value - 1));
+    }
+    else if (tree.kids.empty()) {
+        leaves.push_back(MachineOperand::Imm(node->value));
+    }
+    else {
+        for (size_t i = 0; i < tree.kids.size(); i++) {
+            bindLeaves(tree.kids[i], node->kids[i], leaves);
+        }
+    }
+}
+
+MachineOperand InstructionSelector::emitCode(const Rule &rule, const std::vector<MachineOperand> &leaves) {
+    if (rule.code[0] == '=') {
+        return leaves[std::stoi(rule.code.substr(2)) - 1];
+    }
+
+    MachineOperand result = current_function->NewVReg();
+    MachineOperand scratch;
+    std::istringstream code(rule.code);
+    std::string line;
+    while (std::getline(code, line, ';')) {
+        std::istringstream fields(line);
+        std::string opcode, field;
+        fields >> opcode;
+        std::vector<MachineOperand> operands;
+        while (fields >> field) {
+            if (field.back() == ',') {
+                field.pop_back();
+            }
+            if (field == "$0") {
+                operands.push_back(result);
+            }
+            else if (field == "$t") {
+                if (scratch.kind != MachineOperand::Kind::VirtReg) {
+                    scratch = current_function->NewVReg();
+                }
+                operands.push_back(scratch);
+            }
+            else if (field[0] == '$') {
+                operands.push_back(leaves[std::stoi(field.substr(1)) - 1]);
+            }
+            else {
+                operands.push_back(MachineOperand::Imm(std::stoi(field)));
+            }
+        }
+        emit(opcode, std::move(operands));
+    }
+    return result;
+}
+
+void InstructionSelector::emit(const std::string &opcode, std::vector<MachineOperand> operands) {
+    current_block->AddInstr(MachineInstr(opcode, std::move(operands)));
+}
+
+void InstructionSelector::Dump() const {
+    for (size_t i = 0; i < rules.size(); i++) {
+        if (rule_hits[i] > 0) {
+            std::cout << "ISel: " << riscv_patterns[i].tree << " " << rule_hits[i] << std::endl;
+        }
+    }
+}
@@ -1,63 +1,127 @@
 // main.cpp
-#include <cassert>
 #include <cstdio>
 #include <iostream>
 #include <fstream>
 #include <memory>
 #include <string>
 #include <functional>
+#include <vector>
 
 #include "ast.hpp"
 #include "visitor.hpp"
+#include "isel.hpp"
+#include "pipeline.hpp"
+#include "elf.hpp"
+#include "models/u74.hpp"
+#include "models/c906.hpp"
 
 // Declare lexer input and parser function
 extern FILE *yyin;
+extern int yylineno;
+extern void yyrestart(FILE *input_file);
 extern int yyparse(std::unique_ptr<BaseAST> &ast);
 
 int main(int argc, const char *argv[]) {
-    // Parse command line arguments.
-    assert(argc == 5);
+    // Parse command line arguments: the mode, then one or more inputs,
+    // -o output, an optional -mcpu=<core> selecting the scheduling model
+    // and an optional -O0 turning off constant folding, in any order.
+    // Several inputs are compiled together into a single output.
+    if (argc < 2) {
+        std::cerr << "Invalid arguments: expected a mode" << std::endl;
+        return 1;
+    }
     std::string mode = argv[1];
-    const char* input = argv[2];
-    const char* output = argv[4];
+    std::vector<const char*> inputs;
+    const char* output = nullptr;
+    const SchedModel *sched_model = &u74_model;
+    bool fold_constants = true;
+    for (int arg = 2; arg < argc; arg++) {
+        std::string option = argv[arg];
+        if (option == "-o" && arg + 1 < argc) {
+            output = argv[++arg];
+        } else if (option == "-mcpu=u74") {
+            sched_model = &u74_model;
+        } else if (option == "-mcpu=c906") {
+            sched_model = &c906_model;
+        } else if (option == "-O0") {
+            fold_constants = false;
+        } else if (option[0] == '-') {
+            std::cerr << "Invalid option: " << option << std::endl;
+            return 1;
+        } else {
+            inputs.push_back(argv[arg]);
+        }
+    }
+    if (inputs.empty() || !output) {
+        std::cerr << "Invalid arguments: expected input files and -o output" << std::endl;
+        return 1;
+    }
 
-    // Open the input file and set it as the input for the lexer.
-    yyin = fopen(input, "r");
-    assert(yyin);
+    // Create the code generation visitor. Every input adds its functions
+    // to the same program.
+    CodeGenVisitor codegenVisitor;
+    codegenVisitor.fold_constants = fold_constants;
 
-    // Call the parser function, which will in turn call the lexer to parse the input file.
-    std::unique_ptr<BaseAST> ast;
-    int ret = yyparse(ast);
-    assert(!ret);
+    for (const char* input : inputs) {
+        // Open the input file and restart the lexer on it.
+        FILE *input_file = fopen(input, "r");
+        if (!input_file) {
+            std::cerr << "Invalid input file: " << input << std::endl;
+            return 1;
+        }
+        yyrestart(input_file);
+        yylineno = 1;
 
-    // Dump AST
-    std::cout << "AST Dump: " << std::endl;
-    ast->Dump();
-    std::cout << std::endl;
+        // Call the parser function, which will in turn call the lexer to parse the input file.
+        // Syntax errors have already been reported by the parser.
+        std::unique_ptr<BaseAST> ast;
+        int ret = yyparse(ast);
+        fclose(input_file);
+        if (ret) {
+            return 1;
+        }
 
-    // Create the code generation visitor
-    CodeGenVisitor codegenVisitor;
+        // Dump AST
+        std::cout << "AST Dump: " << std::endl;
+        ast->Dump();
+        std::cout << std::endl;
 
-    // Traverse the AST
-    ast->Accept(&codegenVisitor);
+        // Traverse the AST
+        ast->Accept(&codegenVisitor);
+    }
 
     // Open the output file to write the results
-    std::ofstream output_file(output);
-    assert(output_file && "Failed to open output file");
+    std::ofstream output_file(output, std::ios::binary);
+    if (!output_file) {
+        std::cerr << "Invalid output file: " << output << std::endl;
+        return 1;
+    }
 
     if (mode == "-koopa") {
         // Output the generated IR
         output_file << codegenVisitor.program.ToString();
-    } else if (mode == "-riscv") {
-        // Output the generated assembly code
+    } else if (mode == "-riscv" || mode == "-elf") {
+        // Output the generated assembly code, or with -elf the object file
+        // assembling it would give
+
+        // Lower the IR to machine instructions over virtual registers
+        InstructionSelector isel;
+        auto machine_program = isel.Run(codegenVisitor.program);
+        isel.Dump();
 
-        // Define the register mapping function
-        auto getRegisterFunc = [&](const std::string &var) -> std::string {
-            return codegenVisitor.getOperand(var);
-        };
+        // Optimize, allocate and schedule each function independently,
+        // in parallel
+        auto pipelines = RunPipelines(*machine_program, *sched_model);
+        for (const auto &pipeline : pipelines) {
+            pipeline->Dump();
+        }
 
-        // Pass the register mapping function to GenerateAssembly
-        output_file << codegenVisitor.program.GenerateAssembly(getRegisterFunc);
+        if (mode == "-elf") {
+            ObjectWriter writer;
+            output_file << writer.Write(*machine_program);
+        } else {
+            output_file << machine_program->ToString();
+        }
     } else {
         std::cerr << "Invalid mode: " << mode << std::endl;
         return 1;
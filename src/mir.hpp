@@ -0,0 +1,209 @@
+// mir.hpp
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Whether value fits the signed 12-bit immediate of I- and S-type
+// instructions
+inline bool FitsImm12(long long value) {
+    return value >= -2048 && value <= 2047;
+}
+
+// Operand of a machine instruction
+struct MachineOperand {
+    enum class Kind { VirtReg, PhysReg, Imm, Mem, Label };
+
+    Kind kind = Kind::Imm;
+    int vreg = -1;     // VirtReg
+    std::string reg;   // PhysReg, or base register of Mem
+    int imm = 0;       // Imm, or offset of Mem
+    std::string label; // Label
+
+    static MachineOperand VReg(int id) {
+        MachineOperand op;
+        op.kind = Kind::VirtReg;
+        op.vreg = id;
+        return op;
+    }
+
+    static MachineOperand PReg(const std::string &name) {
+        MachineOperand op;
+        op.kind = Kind::PhysReg;
+        op.reg = name;
+        return op;
+    }
+
+    static MachineOperand Imm(int value) {
+        MachineOperand op;
+        op.kind = Kind::Imm;
+        op.imm = value;
+        return op;
+    }
+
+    static MachineOperand Mem(const std::string &base, int offset) {
+        MachineOperand op;
+        op.kind = Kind::Mem;
+        op.reg = base;
+        op.imm = offset;
+        return op;
+    }
+
+    static MachineOperand Label(const std::string &name) {
+        MachineOperand op;
+        op.kind = Kind::Label;
+        op.label = name;
+        return op;
+    }
+
+    bool IsReg() const {
+        return kind == Kind::VirtReg || kind == Kind::PhysReg;
+    }
+
+    bool operator==(const MachineOperand &other) const {
+        return kind == other.kind && vreg == other.vreg && reg == other.reg &&
+               imm == other.imm && label == other.label;
+    }
+
+    std::string ToString() const {
+        switch (kind) {
+        case Kind::VirtReg:
+            return "%v" + std::to_string(vreg);
+        case Kind::PhysReg:
+            return reg;
+        case Kind::Imm:
+            return std::to_string(imm);
+        case Kind::Mem:
+            return std::to_string(imm) + "(" + reg + ")";
+        case Kind::Label:
+            return label;
+        }
+        return "";
+    }
+};
+
+// RISC-V instruction. Operands follow assembly order, so the written
+// register, if any, comes first.
+class MachineInstr {
+public:
+    std::string opcode;
+    std::vector<MachineOperand> operands;
+    std::vector<MachineOperand> implicit_uses; // Registers read but not printed, e.g. a0 by ret
+
+    MachineInstr(const std::string &opcode, std::vector<MachineOperand> operands = {})
+        : opcode(opcode), operands(std::move(operands)) {}
+
+    // Number of leading operands written by the instruction. The label of
+    // a call is read, not written; jal names its link register first.
+    int NumDefs() const {
+        if (operands.empty() || opcode == "sw" || opcode == "ret" || opcode == "j" ||
+            opcode == "call" || opcode[0] == 'b') {
+            return 0;
+        }
+        return 1;
+    }
+
+    // Registers read by the instruction, including memory base registers
+    std::vector<MachineOperand> Uses() const {
+        std::vector<MachineOperand> uses;
+        for (size_t i = NumDefs(); i < operands.size(); i++) {
+            if (operands[i].IsReg()) {
+                uses.push_back(operands[i]);
+            }
+            else if (operands[i].kind == MachineOperand::Kind::Mem) {
+                uses.push_back(MachineOperand::PReg(operands[i].reg));
+            }
+        }
+        uses.insert(uses.end(), implicit_uses.begin(), implicit_uses.end());
+        return uses;
+    }
+
+    std::string ToString() const {
+        std::string text = "    " + opcode;
+        for (size_t i = 0; i < operands.size(); i++) {
+            text += (i == 0 ? " " : ", ") + operands[i].ToString();
+        }
+        return text + "\n";
+    }
+};
+
+// Machine basic block
+class MachineBasicBlock {
+public:
+    std::string label;
+    std::vector<MachineInstr> instrs;
+
+    explicit MachineBasicBlock(const std::string &block_label) : label(block_label) {}
+
+    void AddInstr(MachineInstr instr) {
+        instrs.push_back(std::move(instr));
+    }
+
+    std::string ToString() const {
+        std::string asm_code;
+        for (const auto &instr : instrs) {
+            asm_code += instr.ToString();
+        }
+        return asm_code;
+    }
+};
+
+// Stack frame of a function, laid out by FrameLowering
+struct StackFrame {
+    int size = 0; // Multiple of 16; 0 when the function needs no frame
+    std::vector<std::pair<std::string, int>> saved_regs; // Register and its offset from sp
+};
+
+// Machine function
+class MachineFunction {
+public:
+    std::string name;
+    std::vector<std::unique_ptr<MachineBasicBlock>> blocks;
+    StackFrame frame;
+    int num_vregs = 0;
+
+    explicit MachineFunction(const std::string &func_name) : name(func_name) {}
+
+    MachineOperand NewVReg() {
+        return MachineOperand::VReg(num_vregs++);
+    }
+
+    void AddBlock(std::unique_ptr<MachineBasicBlock> block) {
+        blocks.push_back(std::move(block));
+    }
+
+    std::string ToString() const {
+        std::string asm_code;
+        asm_code += "    .text\n";
+        asm_code += "    .globl " + name + "\n";
+        asm_code += name + ":\n";
+        for (size_t i = 0; i < blocks.size(); i++) {
+            // The entry block is reached through the function label
+            if (i > 0) {
+                asm_code += blocks[i]->label + ":\n";
+            }
+            asm_code += blocks[i]->ToString();
+        }
+        return asm_code;
+    }
+};
+
+// Machine program
+class MachineProgram {
+public:
+    std::vector<std::unique_ptr<MachineFunction>> functions;
+
+    void AddFunction(std::unique_ptr<MachineFunction> func) {
+        functions.push_back(std::move(func));
+    }
+
+    std::string ToString() const {
+        std::string asm_code;
+        for (const auto &func : functions) {
+            asm_code += func->ToString();
+        }
+        return asm_code;
+    }
+};
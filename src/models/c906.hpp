@@ -0,0 +1,19 @@
+// models/c906.hpp
+#pragma once
+
+#include "schedmodel.hpp"
+
+// T-Head C906: single-issue in-order with a slower multiplier and divider
+inline const SchedModel c906_model = {
+    "c906",
+    1,
+    {{"alu", 1}, {"mul", 1}, {"div", 1}, {"mem", 1}, {"branch", 1}},
+    {
+        {"alu", {1, "alu", 1}},
+        {"mul", {4, "mul", 1}},
+        {"div", {20, "div", 20}},
+        {"load", {3, "mem", 1}},
+        {"store", {1, "mem", 1}},
+        {"control", {1, "branch", 1}},
+    },
+};
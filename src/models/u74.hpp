@@ -0,0 +1,20 @@
+// models/u74.hpp
+#pragma once
+
+#include "schedmodel.hpp"
+
+// SiFive U74: dual-issue in-order, two ALU pipes, a pipelined multiplier
+// and an iterative divider
+inline const SchedModel u74_model = {
+    "u74",
+    2,
+    {{"alu", 2}, {"mul", 1}, {"div", 1}, {"mem", 1}, {"branch", 1}},
+    {
+        {"alu", {1, "alu", 1}},
+        {"mul", {3, "mul", 1}},
+        {"div", {34, "div", 34}},
+        {"load", {3, "mem", 1}},
+        {"store", {1, "mem", 1}},
+        {"control", {1, "branch", 1}},
+    },
+};
@@ -0,0 +1,120 @@
+// patterns.hpp
+#pragma once
+
+#include <cctype>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Tree of a selection pattern. Inner nodes are IR operators; leaves are
+// either a nonterminal, 'reg' or 'bool' (a register known to hold 0 or 1),
+// or a class of constants:
+//   zero     the constant 0, bound to x0
+//   imm      any constant
+//   bit      0 or 1
+//   imm12    fits the 12-bit immediate field
+//   nimm12   its negation fits, bound negated
+//   imm12p1  its successor fits, bound as c + 1
+//   shamt    a power of two, bound as its log2
+//   mask     a power of two up to 2048, bound as c - 1
+struct PatternTree {
+    std::string op;
+    std::vector<PatternTree> kids;
+};
+
+// One rule of the selector: the tree it covers, the nonterminal it
+// produces and the instructions it costs. In the code, '$0' is the result,
+// '$1'... are the leaves from left to right and '$t' is a scratch virtual
+// register; '=$k' means the result is leaf k itself and no code is needed.
+struct PatternRule {
+    const char *result;
+    const char *tree;
+    int cost;
+    const char *code;
+};
+
+// Rules producing 'bool' also produce 'reg'. Among rules of equal cost the
+// first one wins.
+static const std::vector<PatternRule> riscv_patterns = {
+    // Constants
+    {"bool", "zero", 0, "=$1"},
+    {"bool", "bit", 1, "li $0, $1"},
+    {"reg", "imm", 1, "li $0, $1"},
+
+    // Arithmetic
+    {"reg", "add(reg, reg)", 1, "add $0, $1, $2"},
+    {"reg", "add(reg, imm12)", 1, "addi $0, $1, $2"},
+    {"reg", "add(imm12, reg)", 1, "addi $0, $2, $1"},
+    {"reg", "sub(reg, reg)", 1, "sub $0, $1, $2"},
+    {"reg", "sub(reg, nimm12)", 1, "addi $0, $1, $2"},
+    {"reg", "mul(reg, reg)", 1, "mul $0, $1, $2"},
+    {"reg", "mul(reg, shamt)", 1, "slli $0, $1, $2"},
+    {"reg", "mul(shamt, reg)", 1, "slli $0, $2, $1"},
+    {"reg", "div(reg, reg)", 1, "div $0, $1, $2"},
+    {"reg", "mod(reg, reg)", 1, "rem $0, $1, $2"},
+
+    // Bitwise; on 0/1 operands these are the logical operators
+    {"bool", "and(bool, bool)", 1, "and $0, $1, $2"},
+    {"reg", "and(reg, reg)", 1, "and $0, $1, $2"},
+    {"reg", "and(reg, imm12)", 1, "andi $0, $1, $2"},
+    {"reg", "and(imm12, reg)", 1, "andi $0, $2, $1"},
+    {"bool", "or(bool, bool)", 1, "or $0, $1, $2"},
+    {"reg", "or(reg, reg)", 1, "or $0, $1, $2"},
+    {"reg", "or(reg, imm12)", 1, "ori $0, $1, $2"},
+    {"reg", "or(imm12, reg)", 1, "ori $0, $2, $1"},
+
+    // Comparisons
+    {"bool", "lt(reg, reg)", 1, "slt $0, $1, $2"},
+    {"bool", "lt(reg, imm12)", 1, "slti $0, $1, $2"},
+    {"bool", "gt(reg, reg)", 1, "slt $0, $2, $1"},
+    {"bool", "gt(imm12, reg)", 1, "slti $0, $2, $1"},
+    {"bool", "le(reg, reg)", 2, "slt $t, $2, $1; xori $0, $t, 1"},
+    {"bool", "le(reg, imm12p1)", 1, "slti $0, $1, $2"},
+    {"bool", "ge(reg, reg)", 2, "slt $t, $1, $2; xori $0, $t, 1"},
+    {"bool", "ge(reg, imm12)", 2, "slti $t, $1, $2; xori $0, $t, 1"},
+    {"bool", "ge(imm12p1, reg)", 1, "slti $0, $2, $1"},
+    {"bool", "eq(reg, zero)", 1, "seqz $0, $1"},
+    {"bool", "eq(zero, reg)", 1, "seqz $0, $2"},
+    {"bool", "eq(reg, reg)", 2, "xor $t, $1, $2; seqz $0, $t"},
+    {"bool", "eq(reg, imm12)", 2, "xori $t, $1, $2; seqz $0, $t"},
+    {"bool", "ne(reg, zero)", 1, "snez $0, $1"},
+    {"bool", "ne(zero, reg)", 1, "snez $0, $2"},
+    {"bool", "ne(reg, reg)", 2, "xor $t, $1, $2; snez $0, $t"},
+    {"bool", "ne(reg, imm12)", 2, "xori $t, $1, $2; snez $0, $t"},
+
+    // Combinations the front end produces for '!', '!!', '&&', '||' and
+    // divisibility tests
+    {"bool", "ne(bool, zero)", 0, "=$1"},
+    {"bool", "eq(eq(reg, zero), zero)", 1, "snez $0, $1"},
+    {"bool", "eq(ne(reg, zero), zero)", 1, "seqz $0, $1"},
+    {"bool", "eq(mod(reg, mask), zero)", 2, "andi $t, $1, $2; seqz $0, $t"},
+    {"bool", "ne(mod(reg, mask), zero)", 2, "andi $t, $1, $2; snez $0, $t"},
+};
+
+// Parses the tree syntax of PatternRule, e.g. "eq(mod(reg, mask), zero)"
+PatternTree ParsePatternTree(const std::string &text, size_t &pos) {
+    PatternTree tree;
+    while (pos < text.size() && (std::isalnum(text[pos]) || text[pos] == '_')) {
+        tree.op += text[pos++];
+    }
+    if (pos < text.size() && text[pos] == '(') {
+        do {
+            pos++;
+            while (text[pos] == ' ') {
+                pos++;
+            }
+            tree.kids.push_back(ParsePatternTree(text, pos));
+        } while (text[pos] == ',');
+        if (text[pos] != ')') {
+            std::cerr << "Error: Malformed pattern " << text << std::endl;
+            exit(1);
+        }
+        pos++;
+    }
+    return tree;
+}
+
+PatternTree ParsePatternTree(const std::string &text) {
+    size_t pos = 0;
+    return ParsePatternTree(text, pos);
+}
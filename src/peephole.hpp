@@ -0,0 +1,253 @@
+// peephole.hpp
+#pragma once
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "mir.hpp"
+
+// Local rewrites over machine IR. The pre-allocation rules work on virtual
+// registers, where every register has a single definition; the
+// post-allocation rules clean up what register assignment leaves behind.
+class PeepholeOptimizer {
+public:
+    void RunPreRA(MachineProgram &program);
+    void RunPostRA(MachineProgram &program);
+
+    void Dump() const;
+
+private:
+    bool copyPropagate(MachineFunction &func);
+    bool simplifyBooleans(MachineFunction &func);
+    bool foldImmediates(MachineFunction &func);
+    bool removeDeadCode(MachineFunction &func);
+
+    void hit(const std::string &rule) { hits[rule]++; }
+
+    std::map<std::string, int> hits; // Rule name -> times applied
+};
+
+// Implementations of PeepholeOptimizer methods
+
+void PeepholeOptimizer::RunPreRA(MachineProgram &program) {
+    for (auto &func : program.functions) {
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            changed |= simplifyBooleans(*func);
+            changed |= copyPropagate(*func);
+            changed |= foldImmediates(*func);
+            changed |= removeDeadCode(*func);
+        }
+    }
+}
+
+bool PeepholeOptimizer::copyPropagate(MachineFunction &func) {
+    // 'mv vA, vB' between virtual registers: vA is an alias of vB
+    std::unordered_map<int, MachineOperand> copies;
+    for (auto &block : func.blocks) {
+        for (const auto &instr : block->instrs) {
+            if (instr.opcode == "mv" &&
+                instr.operands[0].kind == MachineOperand::Kind::VirtReg &&
+                instr.operands[1].kind == MachineOperand::Kind::VirtReg) {
+                copies[instr.operands[0].vreg] = instr.operands[1];
+            }
+        }
+    }
+    if (copies.empty()) {
+        return false;
+    }
+
+    for (auto &block : func.blocks) {
+        std::vector<MachineInstr> instrs;
+        for (auto &instr : block->instrs) {
+            if (instr.opcode == "mv" && instr.operands[0].kind == MachineOperand::Kind::VirtReg &&
+                copies.count(instr.operands[0].vreg)) {
+                hit("copy-prop");
+                continue;
+            }
+            for (size_t i = instr.NumDefs(); i < instr.operands.size(); i++) {
+                auto &op = instr.operands[i];
+                while (op.kind == MachineOperand::Kind::VirtReg && copies.count(op.vreg)) {
+                    op = copies[op.vreg];
+                }
+            }
+            instrs.push_back(std::move(instr));
+        }
+        block->instrs = std::move(instrs);
+    }
+    return true;
+}
+
+bool PeepholeOptimizer::simplifyBooleans(MachineFunction &func) {
+    // snez of a value that is already 0 or 1 is a copy
+    std::unordered_set<int> booleans;
+    bool changed = false;
+    for (auto &block : func.blocks) {
+        for (auto &instr : block->instrs) {
+            const std::string &opc = instr.opcode;
+            if (instr.NumDefs() == 0 || instr.operands[0].kind != MachineOperand::Kind::VirtReg) {
+                continue;
+            }
+
+            auto isBoolean = [&](const MachineOperand &op) {
+                return op.kind == MachineOperand::Kind::VirtReg && booleans.count(op.vreg);
+            };
+
+            if (opc == "snez" && isBoolean(instr.operands[1])) {
+                instr.opcode = "mv";
+                hit("bool-norm");
+                changed = true;
+            }
+
+            if (opc == "slt" || opc == "sltu" || opc == "slti" || opc == "sltiu" ||
+                opc == "seqz" || opc == "snez" ||
+                (opc == "xori" && isBoolean(instr.operands[1]) && instr.operands[2].imm == 1) ||
+                ((opc == "and" || opc == "or") && isBoolean(instr.operands[1]) && isBoolean(instr.operands[2])) ||
+                (opc == "mv" && isBoolean(instr.operands[1]))) {
+                booleans.insert(instr.operands[0].vreg);
+            }
+        }
+    }
+    return changed;
+}
+
+bool PeepholeOptimizer::foldImmediates(MachineFunction &func) {
+    // Immediate forms of register-register instructions. The bool says
+    // whether the instruction is commutative, so a constant on the left can
+    // be folded as well.
+    static const std::unordered_map<std::string, std::pair<std::string, bool>> immediate_forms = {
+        {"add", {"addi", true}},
+        {"and", {"andi", true}},
+        {"or", {"ori", true}},
+        {"xor", {"xori", true}},
+        {"slt", {"slti", false}},
+        {"sltu", {"sltiu", false}},
+        {"sub", {"addi", false}},
+    };
+
+    // Constants loaded by 'li' into virtual registers; the definition can
+    // be anywhere before the use since virtual registers are never redefined
+    std::unordered_map<int, int> constants;
+    for (auto &block : func.blocks) {
+        for (const auto &instr : block->instrs) {
+            if (instr.opcode == "li" && instr.operands[0].kind == MachineOperand::Kind::VirtReg) {
+                constants[instr.operands[0].vreg] = instr.operands[1].imm;
+            }
+        }
+    }
+
+    auto constantOf = [&](const MachineOperand &op, int &value) {
+        if (op.kind != MachineOperand::Kind::VirtReg || !constants.count(op.vreg)) {
+            return false;
+        }
+        value = constants[op.vreg];
+        return true;
+    };
+
+    bool changed = false;
+    for (auto &block : func.blocks) {
+        for (auto &instr : block->instrs) {
+            auto form = immediate_forms.find(instr.opcode);
+            if (form == immediate_forms.end()) {
+                continue;
+            }
+
+            int value;
+            if (constantOf(instr.operands[2], value)) {
+                // 'sub rd, rs, c' becomes 'addi rd, rs, -c'
+                long long imm = instr.opcode == "sub" ? -(long long)value : value;
+                if (FitsImm12(imm)) {
+                    instr.opcode = form->second.first;
+                    instr.operands[2] = MachineOperand::Imm(imm);
+                    hit("imm-fold");
+                    changed = true;
+                }
+            }
+            else if (form->second.second && constantOf(instr.operands[1], value) && FitsImm12(value)) {
+                instr.opcode = form->second.first;
+                instr.operands[1] = instr.operands[2];
+                instr.operands[2] = MachineOperand::Imm(value);
+                hit("imm-fold");
+                changed = true;
+            }
+        }
+    }
+    return changed;
+}
+
+bool PeepholeOptimizer::removeDeadCode(MachineFunction &func) {
+    // Instructions whose only effect is a virtual register nobody reads,
+    // typically the 'li' left behind by immediate folding
+    std::unordered_set<int> used;
+    for (auto &block : func.blocks) {
+        for (const auto &instr : block->instrs) {
+            for (const auto &use : instr.Uses()) {
+                if (use.kind == MachineOperand::Kind::VirtReg) {
+                    used.insert(use.vreg);
+                }
+            }
+        }
+    }
+
+    bool changed = false;
+    for (auto &block : func.blocks) {
+        std::vector<MachineInstr> instrs;
+        for (auto &instr : block->instrs) {
+            if (instr.NumDefs() == 1 && instr.operands[0].kind == MachineOperand::Kind::VirtReg &&
+                !used.count(instr.operands[0].vreg)) {
+                hit("dead-code");
+                changed = true;
+                continue;
+            }
+            instrs.push_back(std::move(instr));
+        }
+        block->instrs = std::move(instrs);
+    }
+    return changed;
+}
+
+void PeepholeOptimizer::RunPostRA(MachineProgram &program) {
+    for (auto &func : program.functions) {
+        for (size_t b = 0; b < func->blocks.size(); b++) {
+            auto &block = func->blocks[b];
+            std::vector<MachineInstr> instrs;
+            for (size_t i = 0; i < block->instrs.size(); i++) {
+                auto &instr = block->instrs[i];
+
+                // Copies the allocator coalesced into a single register
+                if (instr.opcode == "mv" && instr.operands[0] == instr.operands[1]) {
+                    hit("self-move");
+                    continue;
+                }
+                if (instr.opcode == "addi" && instr.operands[0] == instr.operands[1] &&
+                    instr.operands[2].imm == 0) {
+                    hit("addi-zero");
+                    continue;
+                }
+                // A jump to the block laid out right after this one
+                if (instr.opcode == "j" && i + 1 == block->instrs.size() &&
+                    b + 1 < func->blocks.size() &&
+                    instr.operands[0].label == func->blocks[b + 1]->label) {
+                    hit("jump-next");
+                    continue;
+                }
+                instrs.push_back(std::move(instr));
+            }
+            block->instrs = std::move(instrs);
+        }
+    }
+}
+
+void PeepholeOptimizer::Dump() const {
+    std::cout << "Peephole:";
+    for (const auto &rule : {"bool-norm", "copy-prop", "imm-fold", "dead-code",
+                             "self-move", "addi-zero", "jump-next"}) {
+        auto it = hits.find(rule);
+        std::cout << " " << rule << " " << (it == hits.end() ? 0 : it->second);
+    }
+    std::cout << std::endl;
+}
@@ -0,0 +1,97 @@
+// pipeline.hpp
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "mir.hpp"
+#include "peephole.hpp"
+#include "constmat.hpp"
+#include "regalloc.hpp"
+#include "sched.hpp"
+
+// Machine passes from selected instructions to final code for a single
+// function. Every pipeline owns its passes and their statistics, so
+// pipelines for different functions can run on separate threads.
+class FunctionPipeline {
+public:
+    explicit FunctionPipeline(const SchedModel &model) : scheduler(model) {}
+
+    void Run(std::unique_ptr<MachineFunction> &func);
+
+    void Dump() const;
+
+private:
+    PeepholeOptimizer peephole;
+    ConstantMaterializer constmat;
+    ListScheduler scheduler;
+    RegisterAllocator allocator;
+};
+
+// Runs a FunctionPipeline over every function of the program, spread over
+// up to one thread per core. Pipelines are returned in function order.
+std::vector<std::unique_ptr<FunctionPipeline>> RunPipelines(MachineProgram &program, const SchedModel &model);
+
+// Implementations of FunctionPipeline methods
+
+void FunctionPipeline::Run(std::unique_ptr<MachineFunction> &func) {
+    // The passes work on whole programs, so the function is lent to a
+    // program of its own
+    MachineProgram program;
+    program.AddFunction(std::move(func));
+
+    peephole.RunPreRA(program);
+
+    // One register per distinct constant; the allocator recomputes
+    // these instead of spilling them
+    constmat.RunPreRA(program);
+
+    // Schedule once on virtual registers, where only true dependences
+    // constrain the order, and again after allocation to place the
+    // reloads and frame code
+    scheduler.Run(program, false);
+
+    // Assign registers and stack slots, then lay out stack frames
+    allocator.Run(program);
+
+    peephole.RunPostRA(program);
+    constmat.RunPostRA(program);
+    scheduler.Run(program, true);
+
+    func = std::move(program.functions.front());
+}
+
+void FunctionPipeline::Dump() const {
+    allocator.Dump();
+    peephole.Dump();
+    constmat.Dump();
+    scheduler.Dump();
+}
+
+std::vector<std::unique_ptr<FunctionPipeline>> RunPipelines(MachineProgram &program, const SchedModel &model) {
+    std::vector<std::unique_ptr<FunctionPipeline>> pipelines;
+    for (size_t i = 0; i < program.functions.size(); i++) {
+        pipelines.push_back(std::make_unique<FunctionPipeline>(model));
+    }
+
+    // Workers take the next unprocessed function until none are left
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t i = next++; i < pipelines.size(); i = next++) {
+            pipelines[i]->Run(program.functions[i]);
+        }
+    };
+
+    size_t num_threads = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), pipelines.size());
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < num_threads; i++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    return pipelines;
+}
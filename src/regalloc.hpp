@@ -0,0 +1,371 @@
+// regalloc.hpp
+#pragma once
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "mir.hpp"
+#include "frame.hpp"
+
+// Live range of a virtual register. Instruction i reads its operands at
+// position 2i and writes its result at 2i + 1, so a value dying at an
+// instruction can share a register with that instruction's result.
+struct LiveInterval {
+    int vreg = -1;
+    int start = 0;
+    int end = 0;
+    double spill_cost = 0; // Defs and uses, each weighted by 10^loop_depth
+    std::string reg;       // Assigned register, empty when spilled
+    bool spilled = false;
+    bool remat = false;    // Defined by 'li', so a spill can recompute it
+    int remat_value = 0;
+};
+
+// Per-function allocation summary
+struct RegAllocStats {
+    std::string function;
+    int values = 0;
+    int max_pressure = 0;
+    int registers_used = 0;
+    int spilled = 0;
+    int rematerialized = 0;
+    int spill_slots = 0;
+    int saved_regs = 0;
+    int frame_size = 0;
+};
+
+// Linear-scan register allocator over machine IR
+class RegisterAllocator {
+public:
+    void Run(MachineProgram &program);
+    void Run(MachineFunction &func);
+
+    void Dump() const;
+
+private:
+    std::vector<LiveInterval> computeIntervals(const MachineFunction &func) const;
+    std::unordered_map<std::string, std::vector<std::pair<int, int>>>
+        computeFixedRanges(const MachineFunction &func) const;
+    void rewrite(MachineFunction &func, const std::vector<LiveInterval> &intervals,
+                 const std::vector<int> &spill_offsets) const;
+
+    std::vector<RegAllocStats> stats;
+};
+
+// Registers available to virtual registers, in allocation order.
+// Caller-saved ones come first since they cost nothing in a leaf; a0 is
+// the last of them so it is usually still free for the value being
+// returned. Callee-saved ones are used before anything is spilled, at the
+// price of a save and restore. spill_scratch_regs are kept out of the pool.
+static const std::vector<std::string> allocatable_regs = {
+    "t0", "t1", "t2", "t3", "t4",
+    "a1", "a2", "a3", "a4", "a5", "a6", "a7", "a0",
+    "s1", "s2", "s3", "s4", "s5", "s6", "s7", "s8", "s9", "s10", "s11",
+};
+
+// Registers used to reload spilled values around the instruction that
+// reads or writes them
+static const std::string spill_scratch_regs[2] = {"t5", "t6"};
+
+// Implementations of RegisterAllocator methods
+
+void RegisterAllocator::Run(MachineProgram &program) {
+    for (auto &func : program.functions) {
+        Run(*func);
+    }
+}
+
+std::vector<LiveInterval> RegisterAllocator::computeIntervals(const MachineFunction &func) const {
+    // Functions are straight-line code for now, so a live range is simply
+    // the span from the definition to the last use. Every position is at
+    // loop depth 0, so each def and use weighs 10^0.
+    std::vector<LiveInterval> intervals(func.num_vregs);
+    const double weight = 1;
+
+    int index = 0;
+    for (const auto &block : func.blocks) {
+        for (const auto &instr : block->instrs) {
+            for (const auto &use : instr.Uses()) {
+                if (use.kind == MachineOperand::Kind::VirtReg) {
+                    intervals[use.vreg].end = 2 * index;
+                    intervals[use.vreg].spill_cost += weight;
+                }
+            }
+            for (int i = 0; i < instr.NumDefs(); i++) {
+                const auto &def = instr.operands[i];
+                if (def.kind == MachineOperand::Kind::VirtReg && intervals[def.vreg].vreg < 0) {
+                    intervals[def.vreg].vreg = def.vreg;
+                    intervals[def.vreg].start = intervals[def.vreg].end = 2 * index + 1;
+                    intervals[def.vreg].spill_cost += weight;
+                    if (instr.opcode == "li") {
+                        intervals[def.vreg].remat = true;
+                        intervals[def.vreg].remat_value = instr.operands[1].imm;
+                    }
+                }
+            }
+            index++;
+        }
+    }
+
+    // A rematerialized value costs no store and no memory access, only
+    // the 'li' repeated at each use
+    for (auto &interval : intervals) {
+        if (interval.remat) {
+            interval.spill_cost /= 2;
+        }
+    }
+
+    // Virtual registers are numbered in selection order, which need not
+    // match definition order; linear scan wants them sorted by start
+    std::vector<LiveInterval> sorted;
+    for (const auto &interval : intervals) {
+        if (interval.vreg >= 0) {
+            sorted.push_back(interval);
+        }
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const LiveInterval &a, const LiveInterval &b) {
+        return a.start < b.start;
+    });
+    return sorted;
+}
+
+std::unordered_map<std::string, std::vector<std::pair<int, int>>>
+RegisterAllocator::computeFixedRanges(const MachineFunction &func) const {
+    // Ranges over which instruction selection already pinned a physical
+    // register, e.g. a0 between 'mv a0' and 'ret'
+    std::unordered_map<std::string, std::vector<std::pair<int, int>>> ranges;
+    int index = 0;
+    for (const auto &block : func.blocks) {
+        for (const auto &instr : block->instrs) {
+            for (const auto &use : instr.Uses()) {
+                if (use.kind == MachineOperand::Kind::PhysReg && !ranges[use.reg].empty()) {
+                    ranges[use.reg].back().second = 2 * index;
+                }
+            }
+            for (int i = 0; i < instr.NumDefs(); i++) {
+                const auto &def = instr.operands[i];
+                if (def.kind == MachineOperand::Kind::PhysReg) {
+                    ranges[def.reg].push_back({2 * index + 1, 2 * index + 1});
+                }
+            }
+            index++;
+        }
+    }
+    return ranges;
+}
+
+void RegisterAllocator::Run(MachineFunction &func) {
+    std::vector<LiveInterval> intervals = computeIntervals(func);
+    auto fixed = computeFixedRanges(func);
+
+    // Values copied into a physical register prefer that register, which
+    // turns the copy into a self-move for the peephole pass to delete; this
+    // is how the returned value lands in a0
+    std::unordered_map<int, std::string> hints;
+    for (const auto &block : func.blocks) {
+        for (const auto &instr : block->instrs) {
+            if (instr.opcode == "mv" &&
+                instr.operands[0].kind == MachineOperand::Kind::PhysReg &&
+                instr.operands[1].kind == MachineOperand::Kind::VirtReg) {
+                hints[instr.operands[1].vreg] = instr.operands[0].reg;
+            }
+        }
+    }
+
+    auto conflictsWithFixed = [&](const std::string &reg, const LiveInterval &interval) {
+        auto it = fixed.find(reg);
+        if (it == fixed.end()) {
+            return false;
+        }
+        for (const auto &range : it->second) {
+            if (range.first <= interval.end && interval.start <= range.second) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    std::vector<LiveInterval *> active;
+    std::unordered_map<std::string, LiveInterval *> occupied; // Register -> active interval
+    std::vector<std::string> used_regs;
+    RegAllocStats stat;
+    stat.function = func.name;
+    stat.values = intervals.size();
+
+    for (auto &cur : intervals) {
+        for (auto it = active.begin(); it != active.end();) {
+            if ((*it)->end < cur.start) {
+                occupied.erase((*it)->reg);
+                it = active.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+        stat.max_pressure = std::max<int>(stat.max_pressure, active.size() + 1);
+
+        auto isFree = [&](const std::string &reg) {
+            return !occupied.count(reg) && !conflictsWithFixed(reg, cur);
+        };
+
+        // Take the hinted register if it is free, otherwise the first free
+        // register in pool order
+        std::string chosen;
+        auto hint = hints.find(cur.vreg);
+        if (hint != hints.end() && isFree(hint->second) &&
+            std::find(allocatable_regs.begin(), allocatable_regs.end(), hint->second) != allocatable_regs.end()) {
+            chosen = hint->second;
+        }
+        for (size_t i = 0; chosen.empty() && i < allocatable_regs.size(); i++) {
+            if (isFree(allocatable_regs[i])) {
+                chosen = allocatable_regs[i];
+            }
+        }
+
+        if (chosen.empty()) {
+            // Spill whichever live interval is cheapest per position it
+            // covers; if that is an active one whose register cur may use,
+            // cur takes the register over
+            LiveInterval *victim = &cur;
+            double victim_density = cur.spill_cost / (cur.end - cur.start + 1);
+            for (auto *interval : active) {
+                double density = interval->spill_cost / (interval->end - interval->start + 1);
+                if (density < victim_density && !conflictsWithFixed(interval->reg, cur)) {
+                    victim = interval;
+                    victim_density = density;
+                }
+            }
+            if (victim != &cur) {
+                cur.reg = victim->reg;
+                occupied[cur.reg] = &cur;
+                *std::find(active.begin(), active.end(), victim) = &cur;
+            }
+            victim->reg.clear();
+            victim->spilled = true;
+            continue;
+        }
+
+        cur.reg = chosen;
+        occupied[chosen] = &cur;
+        active.push_back(&cur);
+        if (std::find(used_regs.begin(), used_regs.end(), chosen) == used_regs.end()) {
+            used_regs.push_back(chosen);
+        }
+    }
+
+    // Only values that cannot be recomputed need a stack slot
+    std::vector<std::pair<int, int>> spill_ranges;
+    for (const auto &interval : intervals) {
+        if (interval.spilled && interval.remat) {
+            stat.rematerialized++;
+        }
+        else if (interval.spilled) {
+            spill_ranges.push_back({interval.start, interval.end});
+        }
+    }
+
+    FrameLowering frame_lowering;
+    std::vector<int> spill_offsets = frame_lowering.AssignSpillSlots(spill_ranges);
+    rewrite(func, intervals, spill_offsets);
+    frame_lowering.Run(func, used_regs);
+
+    stat.spilled = spill_ranges.size();
+    stat.spill_slots = frame_lowering.spill_slots;
+    stat.saved_regs = frame_lowering.saved_regs;
+    stat.frame_size = func.frame.size;
+    stat.registers_used = used_regs.size();
+    stats.push_back(stat);
+}
+
+void RegisterAllocator::rewrite(MachineFunction &func, const std::vector<LiveInterval> &intervals,
+                                const std::vector<int> &spill_offsets) const {
+    std::vector<std::string> regs(func.num_vregs);
+    std::vector<int> slots(func.num_vregs, -1);
+    std::unordered_map<int, int> remat; // Spilled constant -> its value
+    for (size_t i = 0, spill = 0; i < intervals.size(); i++) {
+        if (intervals[i].spilled && intervals[i].remat) {
+            remat[intervals[i].vreg] = intervals[i].remat_value;
+        }
+        else if (intervals[i].spilled) {
+            slots[intervals[i].vreg] = spill_offsets[spill++];
+        }
+        else {
+            regs[intervals[i].vreg] = intervals[i].reg;
+        }
+    }
+
+    for (auto &block : func.blocks) {
+        std::vector<MachineInstr> rewritten;
+        for (auto &instr : block->instrs) {
+            // A rematerialized constant is recomputed at its uses instead
+            if (instr.opcode == "li" && instr.operands[0].kind == MachineOperand::Kind::VirtReg &&
+                remat.count(instr.operands[0].vreg)) {
+                continue;
+            }
+
+            // Spilled operands are reloaded into the scratch registers
+            // before the instruction, and a spilled result is stored back
+            // after it. Operands are read before the result is written, so
+            // the result can always use the first scratch register.
+            std::unordered_map<int, std::string> scratch;
+            int next_scratch = 0;
+            for (size_t i = instr.NumDefs(); i < instr.operands.size(); i++) {
+                const auto &op = instr.operands[i];
+                if (op.kind != MachineOperand::Kind::VirtReg || scratch.count(op.vreg)) {
+                    continue;
+                }
+                if (remat.count(op.vreg)) {
+                    scratch[op.vreg] = spill_scratch_regs[next_scratch++];
+                    rewritten.push_back(MachineInstr("li", {MachineOperand::PReg(scratch[op.vreg]),
+                                                            MachineOperand::Imm(remat[op.vreg])}));
+                }
+                else if (slots[op.vreg] >= 0) {
+                    scratch[op.vreg] = spill_scratch_regs[next_scratch++];
+                    rewritten.push_back(MachineInstr("lw", {MachineOperand::PReg(scratch[op.vreg]),
+                                                            MachineOperand::Mem("sp", slots[op.vreg])}));
+                }
+            }
+
+            int spilled_def = -1;
+            for (size_t i = 0; i < instr.operands.size(); i++) {
+                auto &op = instr.operands[i];
+                if (op.kind != MachineOperand::Kind::VirtReg) {
+                    continue;
+                }
+                if (slots[op.vreg] < 0 && !remat.count(op.vreg)) {
+                    op = MachineOperand::PReg(regs[op.vreg]);
+                }
+                else if ((int)i < instr.NumDefs()) {
+                    spilled_def = op.vreg;
+                    op = MachineOperand::PReg(spill_scratch_regs[0]);
+                }
+                else {
+                    op = MachineOperand::PReg(scratch[op.vreg]);
+                }
+            }
+
+            rewritten.push_back(std::move(instr));
+
+            if (spilled_def >= 0) {
+                rewritten.push_back(MachineInstr("sw", {MachineOperand::PReg(spill_scratch_regs[0]),
+                                                        MachineOperand::Mem("sp", slots[spilled_def])}));
+            }
+        }
+        block->instrs = std::move(rewritten);
+    }
+}
+
+void RegisterAllocator::Dump() const {
+    for (const auto &stat : stats) {
+        std::cout << "RegAlloc @" << stat.function << ": "
+                  << stat.values << " values, "
+                  << "max pressure " << stat.max_pressure << ", "
+                  << stat.registers_used << " registers, "
+                  << stat.spilled << " spilled into " << stat.spill_slots << " slots, "
+                  << stat.rematerialized << " rematerialized, "
+                  << stat.saved_regs << " saved, "
+                  << "frame " << stat.frame_size << " bytes" << std::endl;
+    }
+}
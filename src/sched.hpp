@@ -0,0 +1,355 @@
+// sched.hpp
+#pragma once
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "mir.hpp"
+#include "schedmodel.hpp"
+#include "frame.hpp"
+#include "regalloc.hpp"
+
+// Per-block result of one scheduling run
+struct SchedStats {
+    std::string phase;
+    std::string function;
+    std::string block;
+    int cycles_before = 0;
+    int cycles_after = 0;
+};
+
+// Cycle-driven list scheduler for in-order cores. Instructions are ordered
+// by the longest latency path from them to the end of the block, subject
+// to the issue width and functional units of the SchedModel. Before
+// register allocation it works on virtual registers; afterwards it must
+// also respect reuse of physical registers.
+class ListScheduler {
+public:
+    explicit ListScheduler(const SchedModel &model) : model(model) {}
+
+    void Run(MachineProgram &program, bool post_ra);
+
+    // Cycles for an in-order core to issue the sequence and finish all results
+    int EstimateCycles(const std::vector<MachineInstr> &instrs) const;
+
+    void Dump() const;
+
+private:
+    struct Node {
+        std::vector<std::pair<int, int>> succs; // Successor and edge latency
+        int num_preds = 0;
+        int height = 0;
+    };
+
+    std::vector<Node> buildDAG(const std::vector<MachineInstr> &instrs) const;
+    std::vector<MachineInstr> schedule(const std::vector<MachineInstr> &instrs) const;
+    const SchedClassInfo &classOf(const MachineInstr &instr) const;
+    static int maxPressure(const std::vector<MachineInstr> &instrs);
+
+    const SchedModel &model;
+    std::vector<SchedStats> stats;
+};
+
+// Implementations of ListScheduler methods
+
+const SchedClassInfo &ListScheduler::classOf(const MachineInstr &instr) const {
+    return model.classes.at(SchedClassOf(instr.opcode));
+}
+
+std::vector<ListScheduler::Node> ListScheduler::buildDAG(const std::vector<MachineInstr> &instrs) const {
+    std::vector<Node> nodes(instrs.size());
+    auto addEdge = [&](int from, int to, int latency) {
+        nodes[from].succs.push_back({to, latency});
+        nodes[to].num_preds++;
+    };
+
+    // Two accesses off the same base register at different offsets never
+    // overlap; anything else is assumed to. Per location only the last
+    // store and the loads after it need edges, since earlier accesses are
+    // already ordered before that store.
+    struct Location {
+        int last_store = -1;
+        std::vector<int> loads; // Since last_store
+    };
+    std::unordered_map<std::string, std::map<int, Location>> locations; // Base -> offset -> accesses
+
+    std::unordered_map<std::string, int> last_def;
+    std::unordered_map<std::string, std::vector<int>> readers; // Since last_def
+    for (int j = 0; j < (int)instrs.size(); j++) {
+        const auto &instr = instrs[j];
+        std::string cls = SchedClassOf(instr.opcode);
+
+        for (const auto &use : instr.Uses()) {
+            std::string reg = use.ToString();
+            if (reg == "x0") {
+                continue;
+            }
+            auto def = last_def.find(reg);
+            if (def != last_def.end()) {
+                addEdge(def->second, j, classOf(instrs[def->second]).latency);
+            }
+            readers[reg].push_back(j);
+        }
+
+        for (int i = 0; i < instr.NumDefs(); i++) {
+            std::string reg = instr.operands[i].ToString();
+            // Virtual registers have a single definition, so these edges
+            // only arise for physical registers
+            auto def = last_def.find(reg);
+            if (def != last_def.end()) {
+                addEdge(def->second, j, 1);
+            }
+            for (int reader : readers[reg]) {
+                if (reader != j) {
+                    addEdge(reader, j, 0);
+                }
+            }
+            readers[reg].clear();
+            last_def[reg] = j;
+        }
+
+        const MachineOperand *mem = nullptr;
+        for (const auto &op : instr.operands) {
+            if (op.kind == MachineOperand::Kind::Mem) {
+                mem = &op;
+            }
+        }
+        if (cls == "load" || cls == "store") {
+            bool is_store = cls == "store";
+            auto order = [&](Location &loc) {
+                if (loc.last_store >= 0) {
+                    addEdge(loc.last_store, j, is_store ? 1 : classOf(instrs[loc.last_store]).latency);
+                }
+                if (is_store) {
+                    for (int load : loc.loads) {
+                        addEdge(load, j, 0);
+                    }
+                }
+            };
+            for (auto &base : locations) {
+                if (base.first != mem->reg) {
+                    for (auto &loc : base.second) {
+                        order(loc.second);
+                    }
+                }
+            }
+            Location &own = locations[mem->reg][mem->imm];
+            order(own);
+            if (is_store) {
+                own.last_store = j;
+                own.loads.clear();
+            }
+            else {
+                own.loads.push_back(j);
+            }
+        }
+        else if (cls == "control") {
+            // Control transfers end the block
+            for (int i = 0; i < j; i++) {
+                addEdge(i, j, 0);
+            }
+        }
+    }
+
+    // Edges always point forward, so heights can be filled in backwards
+    for (int i = (int)nodes.size() - 1; i >= 0; i--) {
+        nodes[i].height = classOf(instrs[i]).latency;
+        for (const auto &succ : nodes[i].succs) {
+            nodes[i].height = std::max(nodes[i].height, succ.second + nodes[succ.first].height);
+        }
+    }
+    return nodes;
+}
+
+std::vector<MachineInstr> ListScheduler::schedule(const std::vector<MachineInstr> &instrs) const {
+    std::vector<Node> nodes = buildDAG(instrs);
+    std::vector<int> ready_cycle(nodes.size(), 0);
+    std::unordered_map<std::string, std::vector<int>> unit_busy; // Busy-until cycle per copy
+    for (const auto &unit : model.units) {
+        unit_busy[unit.first].assign(unit.second, 0);
+    }
+
+    // Nodes whose predecessors have all issued wait in pending until
+    // their operands are ready, then in the ready list of their unit,
+    // highest first
+    auto lower = [&](int a, int b) {
+        if (nodes[a].height != nodes[b].height) {
+            return nodes[a].height < nodes[b].height;
+        }
+        return a > b;
+    };
+    auto later = [&](int a, int b) { return ready_cycle[a] > ready_cycle[b]; };
+    std::priority_queue<int, std::vector<int>, decltype(later)> pending(later);
+    std::map<std::string, std::priority_queue<int, std::vector<int>, decltype(lower)>> ready;
+    for (const auto &unit : model.units) {
+        ready.emplace(unit.first, lower);
+    }
+    for (int i = 0; i < (int)nodes.size(); i++) {
+        if (nodes[i].num_preds == 0) {
+            pending.push(i);
+        }
+    }
+
+    std::vector<MachineInstr> order;
+    std::vector<int> released;
+    for (int cycle = 0; order.size() < instrs.size(); cycle++) {
+        while (!pending.empty() && ready_cycle[pending.top()] <= cycle) {
+            ready.at(classOf(instrs[pending.top()]).unit).push(pending.top());
+            pending.pop();
+        }
+
+        // Issue the highest ready node whose unit has a free copy, as
+        // long as the issue width allows
+        for (int issued = 0; issued < model.issue_width; issued++) {
+            int best = -1;
+            std::vector<int>::iterator best_copy;
+            for (auto &unit : ready) {
+                if (unit.second.empty() || (best >= 0 && lower(unit.second.top(), best))) {
+                    continue;
+                }
+                auto &copies = unit_busy[unit.first];
+                auto copy = std::find_if(copies.begin(), copies.end(), [&](int busy) { return busy <= cycle; });
+                if (copy != copies.end()) {
+                    best = unit.second.top();
+                    best_copy = copy;
+                }
+            }
+            if (best < 0) {
+                break;
+            }
+
+            ready.at(classOf(instrs[best]).unit).pop();
+            *best_copy = cycle + classOf(instrs[best]).occupancy;
+            order.push_back(instrs[best]);
+            // Released nodes join pending, so they issue next cycle at
+            // the earliest
+            for (const auto &succ : nodes[best].succs) {
+                ready_cycle[succ.first] = std::max(ready_cycle[succ.first], cycle + succ.second);
+                if (--nodes[succ.first].num_preds == 0) {
+                    released.push_back(succ.first);
+                }
+            }
+        }
+        for (int i : released) {
+            pending.push(i);
+        }
+        released.clear();
+    }
+    return order;
+}
+
+int ListScheduler::EstimateCycles(const std::vector<MachineInstr> &instrs) const {
+    std::unordered_map<std::string, int> reg_ready;
+    std::unordered_map<std::string, std::vector<int>> unit_busy;
+    for (const auto &unit : model.units) {
+        unit_busy[unit.first].assign(unit.second, 0);
+    }
+
+    int cycle = 0, issued = 0, finish = 0;
+    for (const auto &instr : instrs) {
+        const auto &info = classOf(instr);
+
+        // In order: never before the previous instruction, and only once
+        // operands are ready and a unit copy is free
+        int start = cycle;
+        for (const auto &use : instr.Uses()) {
+            auto ready = reg_ready.find(use.ToString());
+            if (ready != reg_ready.end()) {
+                start = std::max(start, ready->second);
+            }
+        }
+        auto &copies = unit_busy[info.unit];
+        auto copy = std::min_element(copies.begin(), copies.end());
+        start = std::max(start, *copy);
+        if (start == cycle && issued == model.issue_width) {
+            start++;
+        }
+
+        if (start > cycle) {
+            cycle = start;
+            issued = 0;
+        }
+        issued++;
+        *copy = start + info.occupancy;
+        for (int i = 0; i < instr.NumDefs(); i++) {
+            reg_ready[instr.operands[i].ToString()] = start + info.latency;
+        }
+        finish = std::max(finish, start + info.latency);
+    }
+    return finish;
+}
+
+int ListScheduler::maxPressure(const std::vector<MachineInstr> &instrs) {
+    std::unordered_map<int, int> last_use;
+    for (int i = 0; i < (int)instrs.size(); i++) {
+        for (const auto &use : instrs[i].Uses()) {
+            if (use.kind == MachineOperand::Kind::VirtReg) {
+                last_use[use.vreg] = i;
+            }
+        }
+    }
+
+    std::unordered_set<int> live;
+    int pressure = 0;
+    for (int i = 0; i < (int)instrs.size(); i++) {
+        for (const auto &use : instrs[i].Uses()) {
+            if (use.kind == MachineOperand::Kind::VirtReg && last_use[use.vreg] == i) {
+                live.erase(use.vreg);
+            }
+        }
+        for (int d = 0; d < instrs[i].NumDefs(); d++) {
+            if (instrs[i].operands[d].kind == MachineOperand::Kind::VirtReg) {
+                live.insert(instrs[i].operands[d].vreg);
+            }
+        }
+        pressure = std::max<int>(pressure, live.size());
+    }
+    return pressure;
+}
+
+void ListScheduler::Run(MachineProgram &program, bool post_ra) {
+    // Before allocation a schedule may not push register pressure past the
+    // caller-saved registers, or past what the block already needed, so
+    // that it never introduces saves or spills
+    const int register_budget = allocatable_regs.size() - callee_saved_regs.size();
+
+    for (auto &func : program.functions) {
+        for (auto &block : func->blocks) {
+            if (block->instrs.empty()) {
+                continue;
+            }
+
+            SchedStats stat;
+            stat.phase = post_ra ? "post-RA" : "pre-RA";
+            stat.function = func->name;
+            stat.block = block->label;
+            stat.cycles_before = stat.cycles_after = EstimateCycles(block->instrs);
+
+            std::vector<MachineInstr> scheduled = schedule(block->instrs);
+            int cycles = EstimateCycles(scheduled);
+            bool accept = cycles < stat.cycles_before;
+            if (accept && !post_ra) {
+                int pressure = maxPressure(scheduled);
+                accept = pressure <= std::max(register_budget, maxPressure(block->instrs));
+            }
+            if (accept) {
+                block->instrs = std::move(scheduled);
+                stat.cycles_after = cycles;
+            }
+            stats.push_back(stat);
+        }
+    }
+}
+
+void ListScheduler::Dump() const {
+    for (const auto &stat : stats) {
+        std::cout << "Sched " << model.name << " " << stat.phase << " @"
+                  << stat.function << " %" << stat.block << ": "
+                  << stat.cycles_before << " -> " << stat.cycles_after << " cycles" << std::endl;
+    }
+}
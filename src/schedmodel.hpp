@@ -0,0 +1,42 @@
+// schedmodel.hpp
+#pragma once
+
+#include <map>
+#include <string>
+
+// Timing of one class of instructions on a core
+struct SchedClassInfo {
+    int latency;      // Cycles until the result can be used
+    std::string unit; // Functional unit the instruction issues to
+    int occupancy;    // Cycles the unit stays busy; > 1 when not pipelined
+};
+
+// Latency and resource model of an in-order core, used by ListScheduler.
+// Each supported core has its own file under models/.
+struct SchedModel {
+    std::string name;
+    int issue_width;                              // Instructions issued per cycle
+    std::map<std::string, int> units;             // Unit name -> number of copies
+    std::map<std::string, SchedClassInfo> classes; // See SchedClassOf
+};
+
+// Scheduling class of a machine opcode: one of "alu", "mul", "div", "load",
+// "store" or "control"
+inline std::string SchedClassOf(const std::string &opcode) {
+    if (opcode == "mul" || opcode == "mulh" || opcode == "mulhu" || opcode == "mulhsu") {
+        return "mul";
+    }
+    if (opcode == "div" || opcode == "divu" || opcode == "rem" || opcode == "remu") {
+        return "div";
+    }
+    if (opcode == "lw") {
+        return "load";
+    }
+    if (opcode == "sw") {
+        return "store";
+    }
+    if (opcode == "ret" || opcode == "j" || opcode == "call" || opcode[0] == 'b') {
+        return "control";
+    }
+    return "alu";
+}
@@ -1,8 +1,10 @@
 // visitor.hpp
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include "ast.hpp"
 #include "ir.hpp"
 
@@ -10,6 +12,7 @@
 class CodeGenVisitor : public ASTVisitor {
 public:
     ProgramIR program;
+    bool fold_constants = true; // Off with -O0, so that the backend sees every operation
 
     void Visit(CompUnitAST *node) override;
     void Visit(FuncDefAST *node) override;
@@ -21,17 +24,18 @@ public:
     void Visit(UnaryExprAST *node) override;
     void Visit(NumberAST *node) override;
 
-    std::string getRegister(const std::string &var);
-    std::string getOperand(const std::string &operand);
-
 private:
+    static bool isConstant(const std::string &value);
+    std::string toBoolean(const std::string &value);
+    std::string emitBinaryOp(const std::string &op, const std::string &lhs, const std::string &rhs);
+    static bool foldConstant(const std::string &op, int lhs, int rhs, std::string &result);
+
     FunctionIR *current_function = nullptr;
     BasicBlockIR *current_block = nullptr;
     std::string last_value; // Store the result as a string (variable or constant)
     int temp_count = 0;
-
-    std::unordered_map<std::string, std::string> reg_map; // Mapping from temp vars to registers
-    int reg_count = 0;
+    std::unordered_set<std::string> bool_values; // Temps already known to hold 0 or 1
+    std::unordered_map<std::string, std::string> value_table; // Instruction text -> temp already holding it
 };
 
 // Implementations of CodeGenVisitor methods
@@ -43,6 +47,14 @@ void CodeGenVisitor::Visit(CompUnitAST *node) {
 }
 
 void CodeGenVisitor::Visit(FuncDefAST *node) {
+    // Functions from every input file share one global namespace
+    for (const auto &func : program.functions) {
+        if (func->name == node->ident) {
+            std::cerr << "Error: Redefinition of function " << node->ident << std::endl;
+            exit(1);
+        }
+    }
+
     node->func_type->Accept(this);
 
     auto func_ir = std::make_unique<FunctionIR>(node->ident);
@@ -50,6 +62,7 @@ void CodeGenVisitor::Visit(FuncDefAST *node) {
 
     auto entry_block = std::make_unique<BasicBlockIR>("entry");
     current_block = entry_block.get();
+    value_table.clear();
 
     if (node->block) {
         node->block->Accept(this);
@@ -82,7 +95,7 @@ void CodeGenVisitor::Visit(StmtAST *node) {
             exit(1);
         }
 
-        if (std::isdigit(last_value[0]) || (last_value[0] == '-' && last_value.size() > 1)) {
+        if (isConstant(last_value)) {
             // last_value is a constant
             int val = std::stoi(last_value);
             auto return_instr = std::make_unique<ReturnIR>(val);
@@ -100,36 +113,51 @@ void CodeGenVisitor::Visit(ExprAST *node) {
 }
 
 void CodeGenVisitor::Visit(BinaryOpAST *node) {
-    node->lhs->Accept(this);
-    std::string lhs_val = last_value;
-
-    node->rhs->Accept(this);
-    std::string rhs_val = last_value;
-
     if (node->op == "and" || node->op == "or") {
-        // Allocate temporary registers for boolean conversion
-        std::string bool1 = "%" + std::to_string(temp_count++);
-        std::string bool2 = "%" + std::to_string(temp_count++);
-        std::string result = "%" + std::to_string(temp_count++);
-
-        auto ne_lhs = std::make_unique<BinaryOpIR>("ne", bool1, lhs_val, "0");
-        current_block->AddInstruction(std::move(ne_lhs));
+        // A constant left operand decides '&&' / '||' on its own:
+        // 0 && rhs is 0 and nonzero || rhs is 1, so rhs is never evaluated.
+        // Otherwise the result is just the truth value of rhs.
+        node->lhs->Accept(this);
+        std::string lhs_val = last_value;
+        bool is_and = node->op == "and";
+
+        if (isConstant(lhs_val)) {
+            if ((std::stoi(lhs_val) != 0) != is_and) {
+                last_value = is_and ? "0" : "1";
+            } else {
+                node->rhs->Accept(this);
+                last_value = toBoolean(last_value);
+            }
+            return;
+        }
 
-        auto ne_rhs = std::make_unique<BinaryOpIR>("ne", bool2, rhs_val, "0");
-        current_block->AddInstruction(std::move(ne_rhs));
+        node->rhs->Accept(this);
+        std::string rhs_val = last_value;
 
-        auto binary_op_ir = std::make_unique<BinaryOpIR>(node->op, result, bool1, bool2);
-        current_block->AddInstruction(std::move(binary_op_ir));
+        if (isConstant(rhs_val)) {
+            if ((std::stoi(rhs_val) != 0) != is_and) {
+                last_value = is_and ? "0" : "1";
+            } else {
+                last_value = toBoolean(lhs_val);
+            }
+            return;
+        }
 
-        last_value = result;
+        // Both sides are only known at run time. Operands produced by a
+        // comparison or another logical operator are already 0/1 and are
+        // combined directly, without another 'ne x, 0'.
+        std::string bool1 = toBoolean(lhs_val);
+        std::string bool2 = toBoolean(rhs_val);
+        last_value = emitBinaryOp(node->op, bool1, bool2);
     }
     else {
-        std::string result = "%" + std::to_string(temp_count++);
+        node->lhs->Accept(this);
+        std::string lhs_val = last_value;
 
-        auto binary_op_ir = std::make_unique<BinaryOpIR>(node->op, result, lhs_val, rhs_val);
-        current_block->AddInstruction(std::move(binary_op_ir));
+        node->rhs->Accept(this);
+        std::string rhs_val = last_value;
 
-        last_value = result;
+        last_value = emitBinaryOp(node->op, lhs_val, rhs_val);
     }
 }
 
@@ -138,21 +166,15 @@ void CodeGenVisitor::Visit(UnaryExprAST *node) {
 
     std::string operand = last_value;
 
-    std::string result = "%" + std::to_string(temp_count++);
-
     if (node->op == "+") {
         // Unary plus, no operation needed
         last_value = operand;
     } else if (node->op == "-") {
         // Generate sub 0, operand
-        auto instr = std::make_unique<BinaryOpIR>("sub", result, "0", operand);
-        current_block->AddInstruction(std::move(instr));
-        last_value = result;
+        last_value = emitBinaryOp("sub", "0", operand);
     } else if (node->op == "!") {
         // Generate eq operand, 0
-        auto instr = std::make_unique<BinaryOpIR>("eq", result, operand, "0");
-        current_block->AddInstruction(std::move(instr));
-        last_value = result;
+        last_value = emitBinaryOp("eq", operand, "0");
     } else {
         std::cerr << "Unsupported unary operator: " << node->op << std::endl;
         exit(1);
@@ -163,35 +185,79 @@ void CodeGenVisitor::Visit(NumberAST *node) {
     last_value = std::to_string(node->value);
 }
 
-std::string CodeGenVisitor::getRegister(const std::string &var) {
-    if (reg_map.find(var) != reg_map.end()) {
-        return reg_map[var];
-    } else {
-        // Assign a new register
-        if (reg_count < 7) {
-            std::string reg = "t" + std::to_string(reg_count++);
-            reg_map[var] = reg;
-            return reg;
-        }
-        else if (reg_count < 15) {
-            std::string reg = "a" + std::to_string(reg_count - 7);
-            reg_count++;
-            reg_map[var] = reg;
-            return reg;
-        }
-        else {
-            std::cerr << "Error: Register overflow\n";
-            exit(1);
+bool CodeGenVisitor::isConstant(const std::string &value) {
+    return std::isdigit(value[0]) || (value[0] == '-' && value.size() > 1);
+}
+
+std::string CodeGenVisitor::toBoolean(const std::string &value) {
+    if (isConstant(value)) {
+        return std::stoi(value) != 0 ? "1" : "0";
+    }
+    if (bool_values.count(value)) {
+        return value;
+    }
+
+    return emitBinaryOp("ne", value, "0");
+}
+
+std::string CodeGenVisitor::emitBinaryOp(const std::string &op, const std::string &lhs, const std::string &rhs) {
+    if (fold_constants && isConstant(lhs) && isConstant(rhs)) {
+        std::string folded;
+        if (foldConstant(op, std::stoi(lhs), std::stoi(rhs), folded)) {
+            return folded;
         }
     }
+
+    // Operands are never redefined within a block, so an instruction with
+    // the same opcode and operands computes the same value. Commutative
+    // operands are ordered so that 'a + b' and 'b + a' share an entry.
+    bool commutative = op == "add" || op == "mul" || op == "eq" ||
+                       op == "ne" || op == "and" || op == "or";
+    std::string key = op + " " + lhs + ", " + rhs;
+    if (commutative && rhs < lhs) {
+        key = op + " " + rhs + ", " + lhs;
+    }
+
+    auto it = value_table.find(key);
+    if (it != value_table.end()) {
+        return it->second;
+    }
+
+    std::string result = "%" + std::to_string(temp_count++);
+    auto binary_op_ir = std::make_unique<BinaryOpIR>(op, result, lhs, rhs);
+    current_block->AddInstruction(std::move(binary_op_ir));
+
+    if (op == "eq" || op == "ne" || op == "lt" || op == "gt" ||
+        op == "le" || op == "ge" || op == "and" || op == "or") {
+        bool_values.insert(result);
+    }
+    value_table[key] = result;
+    return result;
 }
 
-std::string CodeGenVisitor::getOperand(const std::string &operand) {
-    if (operand == "0") {
-        // Map zero to the RISC-V zero register x0
-        return "x0";
-    } else {
-        // Operand is a variable or non-zero constant; return its corresponding register
-        return getRegister(operand);
+bool CodeGenVisitor::foldConstant(const std::string &op, int lhs, int rhs, std::string &result) {
+    // Evaluate in 64 bits and wrap to 32, matching the target's arithmetic.
+    // Division by zero and INT_MIN / -1 are left to run time.
+    int64_t a = lhs, b = rhs, value;
+    if (op == "add") value = a + b;
+    else if (op == "sub") value = a - b;
+    else if (op == "mul") value = a * b;
+    else if (op == "div" || op == "mod") {
+        if (b == 0 || (a == INT32_MIN && b == -1)) {
+            return false;
+        }
+        value = op == "div" ? a / b : a % b;
     }
+    else if (op == "eq") value = a == b;
+    else if (op == "ne") value = a != b;
+    else if (op == "lt") value = a < b;
+    else if (op == "gt") value = a > b;
+    else if (op == "le") value = a <= b;
+    else if (op == "ge") value = a >= b;
+    else if (op == "and") value = a & b;
+    else if (op == "or") value = a | b;
+    else return false;
+
+    result = std::to_string(static_cast<int32_t>(static_cast<uint32_t>(value)));
+    return true;
 }
@@ -0,0 +1,67 @@
+#!/bin/bash
+# Checks that every -elf object matches the -riscv output of the same input
+# assembled without relaxation: .text byte for byte, the symbol table and
+# the relocations. Section symbols and mapping symbols, which assemblers
+# emit differently, are left out of the comparison, and R_RISCV_CALL from
+# older assemblers is read as the equivalent R_RISCV_CALL_PLT.
+# Inputs are every lv1/lv3 test, as is and with -O0, and test/elf/sample.cpp,
+# a machine program with the calls and branches the front end cannot
+# produce yet.
+# Usage: test/check_elf.sh [compiler], from the repository root
+
+COMPILER=${1:-./build/compiler}
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+# Prefer the GNU toolchain, falling back to LLVM
+if command -v riscv64-unknown-elf-as >/dev/null; then
+    ASSEMBLE="riscv64-unknown-elf-as -march=rv32im -mabi=ilp32 -mno-relax"
+    OBJCOPY=riscv64-unknown-elf-objcopy
+    OBJDUMP=riscv64-unknown-elf-objdump
+else
+    ASSEMBLE="llvm-mc -triple=riscv32 -mattr=+m,-relax -filetype=obj"
+    OBJCOPY=llvm-objcopy
+    OBJDUMP=llvm-objdump
+fi
+
+failed=0
+fail() {
+    echo "FAIL: $*"
+    failed=1
+}
+
+# Prints the parts of an object that are compared
+describe() {
+    $OBJCOPY -O binary --only-section=.text "$1" "$1.text"
+    od -An -tx1 -v "$1.text"
+    $OBJDUMP -t "$1" | grep -E '^[0-9a-f]{8} ' | grep -vE '^\S+ .{5}d|\$[xd]' | sort
+    $OBJDUMP -r "$1" | grep -E '^[0-9a-f]{8} ' | awk '{ sub(/^R_RISCV_CALL$/, "R_RISCV_CALL_PLT", $2); print $1, $2, $3 }'
+}
+
+# compare <name> <assembly> <object>
+compare() {
+    $ASSEMBLE "$2" -o "$TMP/ref.o" || { fail "$1: does not assemble"; return; }
+    describe "$3" > "$TMP/out.txt"
+    describe "$TMP/ref.o" > "$TMP/ref.txt"
+    diff "$TMP/ref.txt" "$TMP/out.txt" > /dev/null || fail "$1: -elf differs from assembled -riscv"
+}
+
+for file in test/lv1/*.c test/lv3/*.c; do
+    for flags in "" "-O0"; do
+        $COMPILER -riscv "$file" $flags -o "$TMP/out.s" >/dev/null || { fail "$file $flags: -riscv"; continue; }
+        $COMPILER -elf "$file" $flags -o "$TMP/out.o" >/dev/null || { fail "$file $flags: -elf"; continue; }
+        compare "$file $flags" "$TMP/out.s" "$TMP/out.o"
+    done
+done
+
+if ${CXX:-c++} -std=c++17 -Isrc test/elf/sample.cpp -o "$TMP/sample" &&
+   "$TMP/sample" "$TMP/sample.s" "$TMP/sample.o"; then
+    compare test/elf/sample.cpp "$TMP/sample.s" "$TMP/sample.o"
+else
+    fail "test/elf/sample.cpp: does not build"
+fi
+
+if [ $failed -eq 0 ]; then
+    echo "All checks passed"
+fi
+exit $failed
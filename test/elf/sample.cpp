@@ -0,0 +1,74 @@
+// sample.cpp
+// Builds a machine program with the control flow the front end cannot
+// produce yet: calls to defined and undefined functions, local branches
+// and jumps in both directions, and branches and jumps to symbols outside
+// the object. Writes it as assembly to argv[1] and as an object to argv[2].
+#include <fstream>
+#include <memory>
+#include "mir.hpp"
+#include "elf.hpp"
+
+int main(int argc, const char *argv[]) {
+    if (argc != 3) {
+        std::cerr << "Invalid arguments: expected assembly and object outputs" << std::endl;
+        return 1;
+    }
+
+    auto reg = [](const char *name) { return MachineOperand::PReg(name); };
+    auto imm = [](int value) { return MachineOperand::Imm(value); };
+    auto label = [](const char *name) { return MachineOperand::Label(name); };
+
+    // f: counts a0 down to a1, then folds the result with the pseudo
+    // instructions the encoder expands
+    auto f = std::make_unique<MachineFunction>("f");
+    auto f_entry = std::make_unique<MachineBasicBlock>("f_entry");
+    f_entry->AddInstr(MachineInstr("li", {reg("t0"), imm(-2049)}));
+    f_entry->AddInstr(MachineInstr("li", {reg("t1"), imm(2047)}));
+    f_entry->AddInstr(MachineInstr("blt", {reg("a0"), reg("a1"), label("f_done")}));
+    auto f_loop = std::make_unique<MachineBasicBlock>("f_loop");
+    f_loop->AddInstr(MachineInstr("addi", {reg("a0"), reg("a0"), imm(-1)}));
+    f_loop->AddInstr(MachineInstr("mul", {reg("t0"), reg("t0"), reg("a0")}));
+    f_loop->AddInstr(MachineInstr("bge", {reg("a0"), reg("a1"), label("f_loop")}));
+    auto f_done = std::make_unique<MachineBasicBlock>("f_done");
+    f_done->AddInstr(MachineInstr("mv", {reg("a2"), reg("t0")}));
+    f_done->AddInstr(MachineInstr("seqz", {reg("a3"), reg("a2")}));
+    f_done->AddInstr(MachineInstr("snez", {reg("a4"), reg("a2")}));
+    f_done->AddInstr(MachineInstr("neg", {reg("a5"), reg("a3")}));
+    f_done->AddInstr(MachineInstr("not", {reg("a6"), reg("a4")}));
+    f_done->AddInstr(MachineInstr("nop"));
+    f_done->AddInstr(MachineInstr("sltu", {reg("a0"), reg("a5"), reg("a6")}));
+    f_done->AddInstr(MachineInstr("ret"));
+    f->AddBlock(std::move(f_entry));
+    f->AddBlock(std::move(f_loop));
+    f->AddBlock(std::move(f_done));
+
+    // main: calls f and an undefined function, and leaves through
+    // branches and jumps to undefined symbols
+    auto main_func = std::make_unique<MachineFunction>("main");
+    auto entry = std::make_unique<MachineBasicBlock>("main_entry");
+    entry->AddInstr(MachineInstr("addi", {reg("sp"), reg("sp"), imm(-2048)}));
+    entry->AddInstr(MachineInstr("sw", {reg("ra"), MachineOperand::Mem("sp", 2044)}));
+    entry->AddInstr(MachineInstr("call", {label("f")}));
+    entry->AddInstr(MachineInstr("call", {label("g")}));
+    entry->AddInstr(MachineInstr("bnez", {reg("a0"), label("main_exit")}));
+    entry->AddInstr(MachineInstr("beqz", {reg("a1"), label("far_branch")}));
+    entry->AddInstr(MachineInstr("j", {label("far_jump")}));
+    auto exit_block = std::make_unique<MachineBasicBlock>("main_exit");
+    exit_block->AddInstr(MachineInstr("lui", {reg("t2"), imm(0xfffff)}));
+    exit_block->AddInstr(MachineInstr("srai", {reg("a0"), reg("t2"), imm(31)}));
+    exit_block->AddInstr(MachineInstr("lw", {reg("ra"), MachineOperand::Mem("sp", 2044)}));
+    exit_block->AddInstr(MachineInstr("addi", {reg("sp"), reg("sp"), imm(2047)}));
+    exit_block->AddInstr(MachineInstr("addi", {reg("sp"), reg("sp"), imm(1)}));
+    exit_block->AddInstr(MachineInstr("ret"));
+    main_func->AddBlock(std::move(entry));
+    main_func->AddBlock(std::move(exit_block));
+
+    MachineProgram program;
+    program.AddFunction(std::move(f));
+    program.AddFunction(std::move(main_func));
+
+    std::ofstream(argv[1]) << program.ToString();
+    ObjectWriter writer;
+    std::ofstream(argv[2], std::ios::binary) << writer.Write(program);
+    return 0;
+}
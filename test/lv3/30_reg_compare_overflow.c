@@ -0,0 +1,4 @@
+int main() {
+  return ((-2147483647 - 1) < (2147483647 - 1)) + ((2147483647 - 1) > (-2147483647 - 1)) * 2 +
+         ((2147483647 - 1) <= (-2147483647 - 1)) * 4;
+}
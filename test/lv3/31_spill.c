@@ -0,0 +1,15 @@
+int main() {
+  return (3003 - 2000) * ((3005 - 2000) * ((3007 - 2000) * ((3009 - 2000) * ((3011 - 2000) * (
+         (3013 - 2000) * ((3015 - 2000) * ((3017 - 2000) * ((3019 - 2000) * ((3021 - 2000) * (
+         (3023 - 2000) * ((3025 - 2000) * ((3027 - 2000) * ((3029 - 2000) * ((3031 - 2000) * (
+         (3033 - 2000) * ((3035 - 2000) * ((3037 - 2000) * ((3039 - 2000) * ((3041 - 2000) * (
+         (3043 - 2000) * ((3045 - 2000) * ((3047 - 2000) * ((3049 - 2000) * ((3051 - 2000) * (
+         (3053 - 2000) * ((3055 - 2000) * ((3057 - 2000) * ((3059 - 2000) * ((3061 - 2000) * (
+         (3063 - 2000) * ((3065 - 2000) * ((3067 - 2000) * ((3069 - 2000) * ((3071 - 2000) * (
+         (3073 - 2000) * ((3075 - 2000) * ((3077 - 2000) * ((3079 - 2000) * ((3081 - 2000) * (
+         (3083 - 2000) * ((3085 - 2000) * ((3087 - 2000) * ((3089 - 2000) * ((3091 - 2000) * (
+         (3093 - 2000) * ((3095 - 2000) * ((3097 - 2000) * ((3099 - 2000) * ((3101 - 2000) * (
+         (3103 - 2000) * ((3105 - 2000) * ((3107 - 2000) * ((3109 - 2000) * ((3111 - 2000) * (
+         (3113 - 2000) * ((3115 - 2000) * ((3117 - 2000) * ((3119 - 2000) * (
+         (3121 - 2000) * 1)))))))))))))))))))))))))))))))))))))))))))))))))))))))))));
+}
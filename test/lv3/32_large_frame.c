@@ -0,0 +1,203 @@
+int main() {
+  return (3003 - 2000) * ((3005 - 2000) * ((3007 - 2000) * ((3009 - 2000) * ((3011 - 2000) * (
+         (3013 - 2000) * ((3015 - 2000) * ((3017 - 2000) * ((3019 - 2000) * ((3021 - 2000) * (
+         (3023 - 2000) * ((3025 - 2000) * ((3027 - 2000) * ((3029 - 2000) * ((3031 - 2000) * (
+         (3033 - 2000) * ((3035 - 2000) * ((3037 - 2000) * ((3039 - 2000) * ((3041 - 2000) * (
+         (3043 - 2000) * ((3045 - 2000) * ((3047 - 2000) * ((3049 - 2000) * ((3051 - 2000) * (
+         (3053 - 2000) * ((3055 - 2000) * ((3057 - 2000) * ((3059 - 2000) * ((3061 - 2000) * (
+         (3063 - 2000) * ((3065 - 2000) * ((3067 - 2000) * ((3069 - 2000) * ((3071 - 2000) * (
+         (3073 - 2000) * ((3075 - 2000) * ((3077 - 2000) * ((3079 - 2000) * ((3081 - 2000) * (
+         (3083 - 2000) * ((3085 - 2000) * ((3087 - 2000) * ((3089 - 2000) * ((3091 - 2000) * (
+         (3093 - 2000) * ((3095 - 2000) * ((3097 - 2000) * ((3099 - 2000) * ((3101 - 2000) * (
+         (3103 - 2000) * ((3105 - 2000) * ((3107 - 2000) * ((3109 - 2000) * ((3111 - 2000) * (
+         (3113 - 2000) * ((3115 - 2000) * ((3117 - 2000) * ((3119 - 2000) * ((3121 - 2000) * (
+         (3123 - 2000) * ((3125 - 2000) * ((3127 - 2000) * ((3129 - 2000) * ((3131 - 2000) * (
+         (3133 - 2000) * ((3135 - 2000) * ((3137 - 2000) * ((3139 - 2000) * ((3141 - 2000) * (
+         (3143 - 2000) * ((3145 - 2000) * ((3147 - 2000) * ((3149 - 2000) * ((3151 - 2000) * (
+         (3153 - 2000) * ((3155 - 2000) * ((3157 - 2000) * ((3159 - 2000) * ((3161 - 2000) * (
+         (3163 - 2000) * ((3165 - 2000) * ((3167 - 2000) * ((3169 - 2000) * ((3171 - 2000) * (
+         (3173 - 2000) * ((3175 - 2000) * ((3177 - 2000) * ((3179 - 2000) * ((3181 - 2000) * (
+         (3183 - 2000) * ((3185 - 2000) * ((3187 - 2000) * ((3189 - 2000) * ((3191 - 2000) * (
+         (3193 - 2000) * ((3195 - 2000) * ((3197 - 2000) * ((3199 - 2000) * ((3201 - 2000) * (
+         (3203 - 2000) * ((3205 - 2000) * ((3207 - 2000) * ((3209 - 2000) * ((3211 - 2000) * (
+         (3213 - 2000) * ((3215 - 2000) * ((3217 - 2000) * ((3219 - 2000) * ((3221 - 2000) * (
+         (3223 - 2000) * ((3225 - 2000) * ((3227 - 2000) * ((3229 - 2000) * ((3231 - 2000) * (
+         (3233 - 2000) * ((3235 - 2000) * ((3237 - 2000) * ((3239 - 2000) * ((3241 - 2000) * (
+         (3243 - 2000) * ((3245 - 2000) * ((3247 - 2000) * ((3249 - 2000) * ((3251 - 2000) * (
+         (3253 - 2000) * ((3255 - 2000) * ((3257 - 2000) * ((3259 - 2000) * ((3261 - 2000) * (
+         (3263 - 2000) * ((3265 - 2000) * ((3267 - 2000) * ((3269 - 2000) * ((3271 - 2000) * (
+         (3273 - 2000) * ((3275 - 2000) * ((3277 - 2000) * ((3279 - 2000) * ((3281 - 2000) * (
+         (3283 - 2000) * ((3285 - 2000) * ((3287 - 2000) * ((3289 - 2000) * ((3291 - 2000) * (
+         (3293 - 2000) * ((3295 - 2000) * ((3297 - 2000) * ((3299 - 2000) * ((3301 - 2000) * (
+         (3303 - 2000) * ((3305 - 2000) * ((3307 - 2000) * ((3309 - 2000) * ((3311 - 2000) * (
+         (3313 - 2000) * ((3315 - 2000) * ((3317 - 2000) * ((3319 - 2000) * ((3321 - 2000) * (
+         (3323 - 2000) * ((3325 - 2000) * ((3327 - 2000) * ((3329 - 2000) * ((3331 - 2000) * (
+         (3333 - 2000) * ((3335 - 2000) * ((3337 - 2000) * ((3339 - 2000) * ((3341 - 2000) * (
+         (3343 - 2000) * ((3345 - 2000) * ((3347 - 2000) * ((3349 - 2000) * ((3351 - 2000) * (
+         (3353 - 2000) * ((3355 - 2000) * ((3357 - 2000) * ((3359 - 2000) * ((3361 - 2000) * (
+         (3363 - 2000) * ((3365 - 2000) * ((3367 - 2000) * ((3369 - 2000) * ((3371 - 2000) * (
+         (3373 - 2000) * ((3375 - 2000) * ((3377 - 2000) * ((3379 - 2000) * ((3381 - 2000) * (
+         (3383 - 2000) * ((3385 - 2000) * ((3387 - 2000) * ((3389 - 2000) * ((3391 - 2000) * (
+         (3393 - 2000) * ((3395 - 2000) * ((3397 - 2000) * ((3399 - 2000) * ((3401 - 2000) * (
+         (3403 - 2000) * ((3405 - 2000) * ((3407 - 2000) * ((3409 - 2000) * ((3411 - 2000) * (
+         (3413 - 2000) * ((3415 - 2000) * ((3417 - 2000) * ((3419 - 2000) * ((3421 - 2000) * (
+         (3423 - 2000) * ((3425 - 2000) * ((3427 - 2000) * ((3429 - 2000) * ((3431 - 2000) * (
+         (3433 - 2000) * ((3435 - 2000) * ((3437 - 2000) * ((3439 - 2000) * ((3441 - 2000) * (
+         (3443 - 2000) * ((3445 - 2000) * ((3447 - 2000) * ((3449 - 2000) * ((3451 - 2000) * (
+         (3453 - 2000) * ((3455 - 2000) * ((3457 - 2000) * ((3459 - 2000) * ((3461 - 2000) * (
+         (3463 - 2000) * ((3465 - 2000) * ((3467 - 2000) * ((3469 - 2000) * ((3471 - 2000) * (
+         (3473 - 2000) * ((3475 - 2000) * ((3477 - 2000) * ((3479 - 2000) * ((3481 - 2000) * (
+         (3483 - 2000) * ((3485 - 2000) * ((3487 - 2000) * ((3489 - 2000) * ((3491 - 2000) * (
+         (3493 - 2000) * ((3495 - 2000) * ((3497 - 2000) * ((3499 - 2000) * ((3501 - 2000) * (
+         (3503 - 2000) * ((3505 - 2000) * ((3507 - 2000) * ((3509 - 2000) * ((3511 - 2000) * (
+         (3513 - 2000) * ((3515 - 2000) * ((3517 - 2000) * ((3519 - 2000) * ((3521 - 2000) * (
+         (3523 - 2000) * ((3525 - 2000) * ((3527 - 2000) * ((3529 - 2000) * ((3531 - 2000) * (
+         (3533 - 2000) * ((3535 - 2000) * ((3537 - 2000) * ((3539 - 2000) * ((3541 - 2000) * (
+         (3543 - 2000) * ((3545 - 2000) * ((3547 - 2000) * ((3549 - 2000) * ((3551 - 2000) * (
+         (3553 - 2000) * ((3555 - 2000) * ((3557 - 2000) * ((3559 - 2000) * ((3561 - 2000) * (
+         (3563 - 2000) * ((3565 - 2000) * ((3567 - 2000) * ((3569 - 2000) * ((3571 - 2000) * (
+         (3573 - 2000) * ((3575 - 2000) * ((3577 - 2000) * ((3579 - 2000) * ((3581 - 2000) * (
+         (3583 - 2000) * ((3585 - 2000) * ((3587 - 2000) * ((3589 - 2000) * ((3591 - 2000) * (
+         (3593 - 2000) * ((3595 - 2000) * ((3597 - 2000) * ((3599 - 2000) * ((3601 - 2000) * (
+         (3603 - 2000) * ((3605 - 2000) * ((3607 - 2000) * ((3609 - 2000) * ((3611 - 2000) * (
+         (3613 - 2000) * ((3615 - 2000) * ((3617 - 2000) * ((3619 - 2000) * ((3621 - 2000) * (
+         (3623 - 2000) * ((3625 - 2000) * ((3627 - 2000) * ((3629 - 2000) * ((3631 - 2000) * (
+         (3633 - 2000) * ((3635 - 2000) * ((3637 - 2000) * ((3639 - 2000) * ((3641 - 2000) * (
+         (3643 - 2000) * ((3645 - 2000) * ((3647 - 2000) * ((3649 - 2000) * ((3651 - 2000) * (
+         (3653 - 2000) * ((3655 - 2000) * ((3657 - 2000) * ((3659 - 2000) * ((3661 - 2000) * (
+         (3663 - 2000) * ((3665 - 2000) * ((3667 - 2000) * ((3669 - 2000) * ((3671 - 2000) * (
+         (3673 - 2000) * ((3675 - 2000) * ((3677 - 2000) * ((3679 - 2000) * ((3681 - 2000) * (
+         (3683 - 2000) * ((3685 - 2000) * ((3687 - 2000) * ((3689 - 2000) * ((3691 - 2000) * (
+         (3693 - 2000) * ((3695 - 2000) * ((3697 - 2000) * ((3699 - 2000) * ((3701 - 2000) * (
+         (3703 - 2000) * ((3705 - 2000) * ((3707 - 2000) * ((3709 - 2000) * ((3711 - 2000) * (
+         (3713 - 2000) * ((3715 - 2000) * ((3717 - 2000) * ((3719 - 2000) * ((3721 - 2000) * (
+         (3723 - 2000) * ((3725 - 2000) * ((3727 - 2000) * ((3729 - 2000) * ((3731 - 2000) * (
+         (3733 - 2000) * ((3735 - 2000) * ((3737 - 2000) * ((3739 - 2000) * ((3741 - 2000) * (
+         (3743 - 2000) * ((3745 - 2000) * ((3747 - 2000) * ((3749 - 2000) * ((3751 - 2000) * (
+         (3753 - 2000) * ((3755 - 2000) * ((3757 - 2000) * ((3759 - 2000) * ((3761 - 2000) * (
+         (3763 - 2000) * ((3765 - 2000) * ((3767 - 2000) * ((3769 - 2000) * ((3771 - 2000) * (
+         (3773 - 2000) * ((3775 - 2000) * ((3777 - 2000) * ((3779 - 2000) * ((3781 - 2000) * (
+         (3783 - 2000) * ((3785 - 2000) * ((3787 - 2000) * ((3789 - 2000) * ((3791 - 2000) * (
+         (3793 - 2000) * ((3795 - 2000) * ((3797 - 2000) * ((3799 - 2000) * ((3801 - 2000) * (
+         (3803 - 2000) * ((3805 - 2000) * ((3807 - 2000) * ((3809 - 2000) * ((3811 - 2000) * (
+         (3813 - 2000) * ((3815 - 2000) * ((3817 - 2000) * ((3819 - 2000) * ((3821 - 2000) * (
+         (3823 - 2000) * ((3825 - 2000) * ((3827 - 2000) * ((3829 - 2000) * ((3831 - 2000) * (
+         (3833 - 2000) * ((3835 - 2000) * ((3837 - 2000) * ((3839 - 2000) * ((3841 - 2000) * (
+         (3843 - 2000) * ((3845 - 2000) * ((3847 - 2000) * ((3849 - 2000) * ((3851 - 2000) * (
+         (3853 - 2000) * ((3855 - 2000) * ((3857 - 2000) * ((3859 - 2000) * ((3861 - 2000) * (
+         (3863 - 2000) * ((3865 - 2000) * ((3867 - 2000) * ((3869 - 2000) * ((3871 - 2000) * (
+         (3873 - 2000) * ((3875 - 2000) * ((3877 - 2000) * ((3879 - 2000) * ((3881 - 2000) * (
+         (3883 - 2000) * ((3885 - 2000) * ((3887 - 2000) * ((3889 - 2000) * ((3891 - 2000) * (
+         (3893 - 2000) * ((3895 - 2000) * ((3897 - 2000) * ((3899 - 2000) * ((3901 - 2000) * (
+         (3903 - 2000) * ((3905 - 2000) * ((3907 - 2000) * ((3909 - 2000) * ((3911 - 2000) * (
+         (3913 - 2000) * ((3915 - 2000) * ((3917 - 2000) * ((3919 - 2000) * ((3921 - 2000) * (
+         (3923 - 2000) * ((3925 - 2000) * ((3927 - 2000) * ((3929 - 2000) * ((3931 - 2000) * (
+         (3933 - 2000) * ((3935 - 2000) * ((3937 - 2000) * ((3939 - 2000) * ((3941 - 2000) * (
+         (3943 - 2000) * ((3945 - 2000) * ((3947 - 2000) * ((3949 - 2000) * ((3951 - 2000) * (
+         (3953 - 2000) * ((3955 - 2000) * ((3957 - 2000) * ((3959 - 2000) * ((3961 - 2000) * (
+         (3963 - 2000) * ((3965 - 2000) * ((3967 - 2000) * ((3969 - 2000) * ((3971 - 2000) * (
+         (3973 - 2000) * ((3975 - 2000) * ((3977 - 2000) * ((3979 - 2000) * ((3981 - 2000) * (
+         (3983 - 2000) * ((3985 - 2000) * ((3987 - 2000) * ((3989 - 2000) * ((3991 - 2000) * (
+         (3993 - 2000) * ((3995 - 2000) * ((3997 - 2000) * ((3999 - 2000) * ((4001 - 2000) * (
+         (4003 - 2000) * ((4005 - 2000) * ((4007 - 2000) * ((4009 - 2000) * ((4011 - 2000) * (
+         (4013 - 2000) * ((4015 - 2000) * ((4017 - 2000) * ((4019 - 2000) * ((4021 - 2000) * (
+         (4023 - 2000) * ((4025 - 2000) * ((4027 - 2000) * ((4029 - 2000) * ((4031 - 2000) * (
+         (4033 - 2000) * ((4035 - 2000) * ((4037 - 2000) * ((4039 - 2000) * ((4041 - 2000) * (
+         (4043 - 2000) * ((4045 - 2000) * ((4047 - 2000) * ((4049 - 2000) * ((4051 - 2000) * (
+         (4053 - 2000) * ((4055 - 2000) * ((4057 - 2000) * ((4059 - 2000) * ((4061 - 2000) * (
+         (4063 - 2000) * ((4065 - 2000) * ((4067 - 2000) * ((4069 - 2000) * ((4071 - 2000) * (
+         (4073 - 2000) * ((4075 - 2000) * ((4077 - 2000) * ((4079 - 2000) * ((4081 - 2000) * (
+         (4083 - 2000) * ((4085 - 2000) * ((4087 - 2000) * ((4089 - 2000) * ((4091 - 2000) * (
+         (4093 - 2000) * ((4095 - 2000) * ((4097 - 2000) * ((4099 - 2000) * ((4101 - 2000) * (
+         (4103 - 2000) * ((4105 - 2000) * ((4107 - 2000) * ((4109 - 2000) * ((4111 - 2000) * (
+         (4113 - 2000) * ((4115 - 2000) * ((4117 - 2000) * ((4119 - 2000) * ((4121 - 2000) * (
+         (4123 - 2000) * ((4125 - 2000) * ((4127 - 2000) * ((4129 - 2000) * ((4131 - 2000) * (
+         (4133 - 2000) * ((4135 - 2000) * ((4137 - 2000) * ((4139 - 2000) * ((4141 - 2000) * (
+         (4143 - 2000) * ((4145 - 2000) * ((4147 - 2000) * ((4149 - 2000) * ((4151 - 2000) * (
+         (4153 - 2000) * ((4155 - 2000) * ((4157 - 2000) * ((4159 - 2000) * ((4161 - 2000) * (
+         (4163 - 2000) * ((4165 - 2000) * ((4167 - 2000) * ((4169 - 2000) * ((4171 - 2000) * (
+         (4173 - 2000) * ((4175 - 2000) * ((4177 - 2000) * ((4179 - 2000) * ((4181 - 2000) * (
+         (4183 - 2000) * ((4185 - 2000) * ((4187 - 2000) * ((4189 - 2000) * ((4191 - 2000) * (
+         (4193 - 2000) * ((4195 - 2000) * ((4197 - 2000) * ((4199 - 2000) * ((4201 - 2000) * (
+         (4203 - 2000) * ((4205 - 2000) * ((4207 - 2000) * ((4209 - 2000) * ((4211 - 2000) * (
+         (4213 - 2000) * ((4215 - 2000) * ((4217 - 2000) * ((4219 - 2000) * ((4221 - 2000) * (
+         (4223 - 2000) * ((4225 - 2000) * ((4227 - 2000) * ((4229 - 2000) * ((4231 - 2000) * (
+         (4233 - 2000) * ((4235 - 2000) * ((4237 - 2000) * ((4239 - 2000) * ((4241 - 2000) * (
+         (4243 - 2000) * ((4245 - 2000) * ((4247 - 2000) * ((4249 - 2000) * ((4251 - 2000) * (
+         (4253 - 2000) * ((4255 - 2000) * ((4257 - 2000) * ((4259 - 2000) * ((4261 - 2000) * (
+         (4263 - 2000) * ((4265 - 2000) * ((4267 - 2000) * ((4269 - 2000) * ((4271 - 2000) * (
+         (4273 - 2000) * ((4275 - 2000) * ((4277 - 2000) * ((4279 - 2000) * ((4281 - 2000) * (
+         (4283 - 2000) * ((4285 - 2000) * ((4287 - 2000) * ((4289 - 2000) * ((4291 - 2000) * (
+         (4293 - 2000) * ((4295 - 2000) * ((4297 - 2000) * ((4299 - 2000) * ((4301 - 2000) * (
+         (4303 - 2000) * ((4305 - 2000) * ((4307 - 2000) * ((4309 - 2000) * ((4311 - 2000) * (
+         (4313 - 2000) * ((4315 - 2000) * ((4317 - 2000) * ((4319 - 2000) * ((4321 - 2000) * (
+         (4323 - 2000) * ((4325 - 2000) * ((4327 - 2000) * ((4329 - 2000) * ((4331 - 2000) * (
+         (4333 - 2000) * ((4335 - 2000) * ((4337 - 2000) * ((4339 - 2000) * ((4341 - 2000) * (
+         (4343 - 2000) * ((4345 - 2000) * ((4347 - 2000) * ((4349 - 2000) * ((4351 - 2000) * (
+         (4353 - 2000) * ((4355 - 2000) * ((4357 - 2000) * ((4359 - 2000) * ((4361 - 2000) * (
+         (4363 - 2000) * ((4365 - 2000) * ((4367 - 2000) * ((4369 - 2000) * ((4371 - 2000) * (
+         (4373 - 2000) * ((4375 - 2000) * ((4377 - 2000) * ((4379 - 2000) * ((4381 - 2000) * (
+         (4383 - 2000) * ((4385 - 2000) * ((4387 - 2000) * ((4389 - 2000) * ((4391 - 2000) * (
+         (4393 - 2000) * ((4395 - 2000) * ((4397 - 2000) * ((4399 - 2000) * ((4401 - 2000) * (
+         (4403 - 2000) * ((4405 - 2000) * ((4407 - 2000) * ((4409 - 2000) * ((4411 - 2000) * (
+         (4413 - 2000) * ((4415 - 2000) * ((4417 - 2000) * ((4419 - 2000) * ((4421 - 2000) * (
+         (4423 - 2000) * ((4425 - 2000) * ((4427 - 2000) * ((4429 - 2000) * ((4431 - 2000) * (
+         (4433 - 2000) * ((4435 - 2000) * ((4437 - 2000) * ((4439 - 2000) * ((4441 - 2000) * (
+         (4443 - 2000) * ((4445 - 2000) * ((4447 - 2000) * ((4449 - 2000) * ((4451 - 2000) * (
+         (4453 - 2000) * ((4455 - 2000) * ((4457 - 2000) * ((4459 - 2000) * ((4461 - 2000) * (
+         (4463 - 2000) * ((4465 - 2000) * ((4467 - 2000) * ((4469 - 2000) * ((4471 - 2000) * (
+         (4473 - 2000) * ((4475 - 2000) * ((4477 - 2000) * ((4479 - 2000) * ((4481 - 2000) * (
+         (4483 - 2000) * ((4485 - 2000) * ((4487 - 2000) * ((4489 - 2000) * ((4491 - 2000) * (
+         (4493 - 2000) * ((4495 - 2000) * ((4497 - 2000) * ((4499 - 2000) * ((4501 - 2000) * (
+         (4503 - 2000) * ((4505 - 2000) * ((4507 - 2000) * ((4509 - 2000) * ((4511 - 2000) * (
+         (4513 - 2000) * ((4515 - 2000) * ((4517 - 2000) * ((4519 - 2000) * ((4521 - 2000) * (
+         (4523 - 2000) * ((4525 - 2000) * ((4527 - 2000) * ((4529 - 2000) * ((4531 - 2000) * (
+         (4533 - 2000) * ((4535 - 2000) * ((4537 - 2000) * ((4539 - 2000) * ((4541 - 2000) * (
+         (4543 - 2000) * ((4545 - 2000) * ((4547 - 2000) * ((4549 - 2000) * ((4551 - 2000) * (
+         (4553 - 2000) * ((4555 - 2000) * ((4557 - 2000) * ((4559 - 2000) * ((4561 - 2000) * (
+         (4563 - 2000) * ((4565 - 2000) * ((4567 - 2000) * ((4569 - 2000) * ((4571 - 2000) * (
+         (4573 - 2000) * ((4575 - 2000) * ((4577 - 2000) * ((4579 - 2000) * ((4581 - 2000) * (
+         (4583 - 2000) * ((4585 - 2000) * ((4587 - 2000) * ((4589 - 2000) * ((4591 - 2000) * (
+         (4593 - 2000) * ((4595 - 2000) * ((4597 - 2000) * ((4599 - 2000) * ((4601 - 2000) * (
+         (4603 - 2000) * ((4605 - 2000) * ((4607 - 2000) * ((4609 - 2000) * ((4611 - 2000) * (
+         (4613 - 2000) * ((4615 - 2000) * ((4617 - 2000) * ((4619 - 2000) * ((4621 - 2000) * (
+         (4623 - 2000) * ((4625 - 2000) * ((4627 - 2000) * ((4629 - 2000) * ((4631 - 2000) * (
+         (4633 - 2000) * ((4635 - 2000) * ((4637 - 2000) * ((4639 - 2000) * ((4641 - 2000) * (
+         (4643 - 2000) * ((4645 - 2000) * ((4647 - 2000) * ((4649 - 2000) * ((4651 - 2000) * (
+         (4653 - 2000) * ((4655 - 2000) * ((4657 - 2000) * ((4659 - 2000) * ((4661 - 2000) * (
+         (4663 - 2000) * ((4665 - 2000) * ((4667 - 2000) * ((4669 - 2000) * ((4671 - 2000) * (
+         (4673 - 2000) * ((4675 - 2000) * ((4677 - 2000) * ((4679 - 2000) * ((4681 - 2000) * (
+         (4683 - 2000) * ((4685 - 2000) * ((4687 - 2000) * ((4689 - 2000) * ((4691 - 2000) * (
+         (4693 - 2000) * ((4695 - 2000) * ((4697 - 2000) * ((4699 - 2000) * ((4701 - 2000) * (
+         (4703 - 2000) * ((4705 - 2000) * ((4707 - 2000) * ((4709 - 2000) * ((4711 - 2000) * (
+         (4713 - 2000) * ((4715 - 2000) * ((4717 - 2000) * ((4719 - 2000) * ((4721 - 2000) * (
+         (4723 - 2000) * ((4725 - 2000) * ((4727 - 2000) * ((4729 - 2000) * ((4731 - 2000) * (
+         (4733 - 2000) * ((4735 - 2000) * ((4737 - 2000) * ((4739 - 2000) * ((4741 - 2000) * (
+         (4743 - 2000) * ((4745 - 2000) * ((4747 - 2000) * ((4749 - 2000) * ((4751 - 2000) * (
+         (4753 - 2000) * ((4755 - 2000) * ((4757 - 2000) * ((4759 - 2000) * ((4761 - 2000) * (
+         (4763 - 2000) * ((4765 - 2000) * ((4767 - 2000) * ((4769 - 2000) * ((4771 - 2000) * (
+         (4773 - 2000) * ((4775 - 2000) * ((4777 - 2000) * ((4779 - 2000) * ((4781 - 2000) * (
+         (4783 - 2000) * ((4785 - 2000) * ((4787 - 2000) * ((4789 - 2000) * ((4791 - 2000) * (
+         (4793 - 2000) * ((4795 - 2000) * ((4797 - 2000) * ((4799 - 2000) * ((4801 - 2000) * (
+         (4803 - 2000) * ((4805 - 2000) * ((4807 - 2000) * ((4809 - 2000) * ((4811 - 2000) * (
+         (4813 - 2000) * ((4815 - 2000) * ((4817 - 2000) * ((4819 - 2000) * ((4821 - 2000) * (
+         (4823 - 2000) * ((4825 - 2000) * ((4827 - 2000) * ((4829 - 2000) * ((4831 - 2000) * (
+         (4833 - 2000) * ((4835 - 2000) * ((4837 - 2000) * ((4839 - 2000) * ((4841 - 2000) * (
+         (4843 - 2000) * ((4845 - 2000) * ((4847 - 2000) * ((4849 - 2000) * ((4851 - 2000) * (
+         (4853 - 2000) * ((4855 - 2000) * ((4857 - 2000) * ((4859 - 2000) * ((4861 - 2000) * (
+         (4863 - 2000) * ((4865 - 2000) * ((4867 - 2000) * ((4869 - 2000) * ((4871 - 2000) * (
+         (4873 - 2000) * ((4875 - 2000) * ((4877 - 2000) * ((4879 - 2000) * ((4881 - 2000) * (
+         (4883 - 2000) * ((4885 - 2000) * ((4887 - 2000) * ((4889 - 2000) * ((4891 - 2000) * (
+         (4893 - 2000) * ((4895 - 2000) * ((4897 - 2000) * ((4899 - 2000) * ((4901 - 2000) * (
+         (4903 - 2000) * ((4905 - 2000) * ((4907 - 2000) * ((4909 - 2000) * ((4911 - 2000) * (
+         (4913 - 2000) * ((4915 - 2000) * ((4917 - 2000) * ((4919 - 2000) * ((4921 - 2000) * (
+         (4923 - 2000) * ((4925 - 2000) * ((4927 - 2000) * ((4929 - 2000) * ((4931 - 2000) * (
+         (4933 - 2000) * ((4935 - 2000) * ((4937 - 2000) * ((4939 - 2000) * ((4941 - 2000) * (
+         (4943 - 2000) * ((4945 - 2000) * ((4947 - 2000) * ((4949 - 2000) * ((4951 - 2000) * (
+         (4953 - 2000) * ((4955 - 2000) * ((4957 - 2000) * ((4959 - 2000) * ((4961 - 2000) * (
+         (4963 - 2000) * ((4965 - 2000) * ((4967 - 2000) * ((4969 - 2000) * ((4971 - 2000) * (
+         (4973 - 2000) * ((4975 - 2000) * ((4977 - 2000) * ((4979 - 2000) * ((4981 - 2000) * (
+         (4983 - 2000) * ((4985 - 2000) * ((4987 - 2000) * ((4989 - 2000) * ((4991 - 2000) * (
+         (4993 - 2000) * ((4995 - 2000) * ((4997 - 2000) * ((4999 - 2000) * (
+         (5001 - 2000) * 1)))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))));
+}
@@ -0,0 +1,6 @@
+int main() {
+  return ((2047 - 0) <= 2046) + ((2047 - 0) <= 2047) * 2 + (2046 >= (2047 - 0)) * 4 +
+         (2047 >= (2047 - 0)) * 8 + ((2047 - 0) < 2047) * 16 + ((2047 - 0) < 2048) * 32 +
+         (((1 - 0) + 2047) == 2048 && ((1 - 0) + 2048) == 2049) * 64 +
+         (((1 - 0) - 2048) == -2047 && ((1 - 0) - 2049) == -2048) * 128;
+}
@@ -0,0 +1,5 @@
+int main() {
+  return ((6144 - 0) % 2048 == 0) + ((6144 - 0) % 4096 == 0) * 2 + ((0 - 6) % 4 == 0) * 4 +
+         ((0 - 6) % 4 != 0) * 8 + ((0 - 8) % 4 == 0) * 16 + ((0 - 6) % 4 == -2) * 32 +
+         ((7 - 0) % 1 == 0) * 64;
+}
@@ -0,0 +1,5 @@
+int main() {
+  return ((3 - 0) * 1073741824 < 0) + ((1 - 0) * 1073741824 == 1073741824) * 2 +
+         ((5 - 0) * 1 == 5) * 4 + ((5 - 0) * 2048 == 10240) * 8 + ((5 - 0) * 3 == 15) * 16 +
+         ((0 - 1) * 1073741824 == -1073741824) * 32 + (1073741824 * (3 - 0) < 0) * 64;
+}
@@ -0,0 +1,3 @@
+int f() {
+  return -(2147483647 - 7) % 10 + !0;
+}
@@ -0,0 +1,59 @@
+#!/bin/bash
+# Compiles every lv1 and lv3 test to RISC-V, runs it and compares its exit
+# status with the .out file. Each test runs as is, and with -O0 so that no
+# constant folding hides the expression from the backend, once per
+# scheduling model.
+# Each directory under test/multi is compiled as one program from all of
+# its files. With a .out file next to it the program must run as above;
+# without one the compiler must reject it.
+# Needs the toolchain of the development image: clang, ld.lld with the
+# SysY runtime under $CDE_LIBRARY_PATH/riscv32, and qemu-riscv32-static.
+# Usage: test/run_tests.sh [compiler], from the repository root
+
+COMPILER=${1:-./build/compiler}
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+failed=0
+fail() {
+    echo "FAIL: $*"
+    failed=1
+}
+
+# run <expected status> <compiler arguments...>
+run() {
+    local expected=$1
+    shift
+    $COMPILER -riscv "$@" -o "$TMP/out.s" >/dev/null || { fail "$*: compiler failed"; return; }
+    clang "$TMP/out.s" -c -o "$TMP/out.o" -target riscv32-unknown-linux-elf -march=rv32im -mabi=ilp32 ||
+        { fail "$*: does not assemble"; return; }
+    ld.lld "$TMP/out.o" -L"$CDE_LIBRARY_PATH/riscv32" -lsysy -o "$TMP/out" || { fail "$*: does not link"; return; }
+    local status=0
+    qemu-riscv32-static "$TMP/out" >/dev/null || status=$?
+    [ "$status" -eq "$expected" ] || fail "$*: returned $status, expected $expected"
+}
+
+for file in test/lv1/*.c test/lv3/*.c; do
+    expected=$(cat "${file%.c}.out")
+    run "$expected" "$file"
+    run "$expected" "$file" -O0
+    run "$expected" "$file" -O0 -mcpu=c906
+done
+
+for dir in test/multi/*/; do
+    dir=${dir%/}
+    if [ -f "$dir.out" ]; then
+        run "$(cat "$dir.out")" "$dir"/*.c
+        for file in "$dir"/*.c; do
+            func=$(sed -n 's/^int \([a-zA-Z_0-9]*\)().*/\1/p' "$file")
+            grep -q "^$func:" "$TMP/out.s" || fail "$dir: function $func missing from the output"
+        done
+    elif $COMPILER -riscv "$dir"/*.c -o "$TMP/out.s" >/dev/null 2>&1; then
+        fail "$dir: compiled, but should be rejected"
+    fi
+done
+
+if [ $failed -eq 0 ]; then
+    echo "All tests passed"
+fi
+exit $failed